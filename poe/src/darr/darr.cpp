@@ -20,7 +20,7 @@ darrCreate( size_t elementSize, size_t initialSize ) {
   size_t capacity = 1;
 
   while (capacity < initialSize) {
-    initialSize *= 2;
+    capacity *= 2;
   }
 
   DarrHeader *header = (DarrHeader *)calloc(sizeof(DarrHeader) + elementSize * capacity, 1);
@@ -45,19 +45,27 @@ darrReserve( void *array, size_t elementCount ) {
   assert(array != NULL);
 
   DarrHeader *header = (DarrHeader *)array - 1;
-  header->size += elementCount;
+  const size_t size = header->size + elementCount;
 
-  if (header->capacity >= header->size)
+  if (header->capacity >= size) {
+    header->size = size;
     return header + 1;
+  }
+
+  size_t capacity = header->capacity;
 
-  while (header->capacity < header->size)
-    header->capacity *= 2;
+  while (capacity < size)
+    capacity *= 2;
 
-  header = (DarrHeader *)realloc(header, sizeof(DarrHeader) + header->capacity * header->elementSize);
+  header = (DarrHeader *)realloc(header, sizeof(DarrHeader) + capacity * header->elementSize);
 
+  // array is kept unchanged, so it may be destroyed
   if (header == NULL)
     return NULL;
 
+  header->capacity = capacity;
+  header->size = size;
+
   return header + 1;
 } // darrReserve function end
 
@@ -70,7 +78,7 @@ darrTruncCapacity( void *array ) {
   if (header->capacity == header->size)
     return header + 1;
 
-  header = (DarrHeader *)realloc(header, sizeof(DarrHeader) + header->size);
+  header = (DarrHeader *)realloc(header, sizeof(DarrHeader) + header->size * header->elementSize);
 
   if (header == NULL)
     return NULL;
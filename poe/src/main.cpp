@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include "poe/poe.h"
+#include "poe/bench/poe_bench.h"
 
 /**
  * @brief string from stdout getting function
@@ -40,6 +41,26 @@ cliGetString(
   return bptr - buffer;
 } // cliGetString function end
 
+/**
+ * @brief string by first space splitting function
+ * 
+ * @param string string to split (first space is replaced by '\0')
+ * 
+ * @return part of string after first space ("" if there is no space)
+ */
+const char *
+cliSplitString( char *const string ) {
+  assert(string != NULL);
+
+  char *n = strchr(string, ' ');
+
+  if (n == NULL)
+    return "";
+
+  *n = '\0';
+  return n + 1;
+} // cliSplitString function end
+
 /**
  * @brief project main function
  * 
@@ -57,27 +78,98 @@ main( void ) {
   PoeOneginGenerator generator = {0};
   PoeBool generatorIsInit = POE_FALSE;
   FILE *file = NULL;
+  size_t threadCount = 1;
+
+  // loaded text is freed at once with session arena on next load; generator is rebuilt many times
+  // per text (after encoding change, append failure, generator load), so it is a heap one
+  PoeArena sessionArena;
+  poeCreateArena(&sessionArena, 0);
+
+  // every stanza command takes next seed from this stream
+  PoeRandom seedRandom;
+  poeRandomSeed(&seedRandom, (uint64_t)time(NULL), 0);
+
+  // stanza render buffer is reused by all stanza commands
+  PoeOutputBuffer outputBuffer = {0};
 
   static const struct {
     const char
       *load       ,
+      *map        ,
+      *append     ,
+      *stat       ,
+      *stats      ,
+      *statsReset ,
       *stanza     ,
+      *generatorSave,
+      *generatorLoad,
       *help       ,
       *sort       ,
       *sortInitial,
       *sortForward,
       *sortReverse,
+      *sortQsort  ,
+      *sortStd    ,
+      *sortKeyed  ,
+      *sortRadix  ,
+      *sortRhyme  ,
+      *sortParallel,
+      *sortHoare  ,
+      *sortPacked ,
+      *select     ,
+      *selectLast ,
       *write      ,
+      *threads    ,
+      *seed       ,
+      *encoding   ,
+      *externalSort,
+      *bench      ,
+      *benchLoad  ,
+      *benchScan  ,
+      *benchSort  ,
+      *benchParallelSort,
+      *benchAdversarial,
+      *benchSuite ,
+      *benchArray ,
       *quit       ;
   } command = {
     .load        = "load",
+    .map         = "map",
+    .append      = "append",
+    .stat        = "stat",
+    .stats       = "stats",
+    .statsReset  = "reset",
     .stanza      = "stanza",
+    .generatorSave = "gsave",
+    .generatorLoad = "gload",
     .help        = "help",
     .sort        = "sort",
     .sortInitial = "initial",
     .sortForward = "forward",
     .sortReverse = "reverse",
+    .sortQsort   = "qsort",
+    .sortStd     = "std",
+    .sortKeyed   = "keyed",
+    .sortRadix   = "radix",
+    .sortRhyme   = "rhyme",
+    .sortParallel = "parallel",
+    .sortHoare   = "hoare",
+    .sortPacked  = "packed",
+    .select      = "select",
+    .selectLast  = "last",
     .write       = "write",
+    .threads     = "threads",
+    .seed        = "seed",
+    .encoding    = "encoding",
+    .externalSort = "xsort",
+    .bench       = "bench",
+    .benchLoad   = "load",
+    .benchScan   = "scan",
+    .benchSort   = "sort",
+    .benchParallelSort = "psort",
+    .benchAdversarial = "adversarial",
+    .benchSuite  = "suite",
+    .benchArray  = "array",
     .quit        = "quit",
   };
 
@@ -99,29 +191,25 @@ main( void ) {
       continue;
     }
 
-    const char *commandData = "";
-
     // split command and next part
-    {
-      char *n = strchr(buffer, ' ');
-
-      if (n != NULL) {
-        *n = '\0';
-        commandData = n + 1;
-      }
-    }
+    const char *commandData = cliSplitString(buffer);
 
     if (strcmp(buffer, command.load) == 0) {
       if (generatorIsInit) {
         // generator deinitialization
         poeDestroyOneginGenerator(&generator);
         generatorIsInit = POE_FALSE;
+      }
 
-        // text initialization
+      if (textIsInit) {
+        // text deinitialization
         poeDestroyText(&text);
         textIsInit = POE_FALSE;
       }
 
+      poeDestroyArena(&sessionArena);
+      poeCreateArena(&sessionArena, 0);
+
       // TODO Handle errorcode
       int errCode = fopen_s(&file, commandData, "rb");
 
@@ -136,7 +224,11 @@ main( void ) {
         continue;
       }
 
-      if (POE_CHECK(poeParseText(file, &text)))
+      PoeStatus status = threadCount == 1
+        ? poeParseText(file, &text, &sessionArena)
+        : poeParseTextParallel(file, &text, threadCount, &sessionArena);
+
+      if (POE_CHECK(status))
         textIsInit = POE_TRUE;
       else
         printf("    error during text file parsing occured\n");
@@ -146,11 +238,397 @@ main( void ) {
       continue;
     }
 
+    if (strcmp(buffer, command.map) == 0) {
+      if (generatorIsInit) {
+        poeDestroyOneginGenerator(&generator);
+        generatorIsInit = POE_FALSE;
+      }
+
+      if (textIsInit) {
+        poeDestroyText(&text);
+        textIsInit = POE_FALSE;
+      }
+
+      poeDestroyArena(&sessionArena);
+      poeCreateArena(&sessionArena, 0);
+
+      PoeStatus status = poeParseTextMapped(commandData, &text, &sessionArena);
+
+      if (POE_CHECK(status))
+        textIsInit = POE_TRUE;
+      else if (status == POE_STATUS_IO_ERROR)
+        printf("    error during \'%s\' file mapping\n", commandData);
+      else
+        printf("    error during text file parsing occured\n");
+
+      continue;
+    }
+
+    if (strcmp(buffer, command.append) == 0) {
+      if (!textIsInit) {
+        printf("    no text to append to\n");
+        continue;
+      }
+
+      // split file name and optional order text is sorted in
+      const char *order = cliSplitString((char *)commandData);
+      PoeStringCompareFn compareFn = NULL;
+
+      if (strcmp(order, command.sortForward) == 0) {
+        compareFn = poeCompareFromStart;
+      } else if (strcmp(order, command.sortReverse) == 0) {
+        compareFn = poeCompareFromEnd;
+      } else if (order[0] != '\0') {
+        printf("    unknown sorting method: \'%s\'\n", order);
+        continue;
+      }
+
+      if (fopen_s(&file, commandData, "rb") != 0 || file == NULL) {
+        printf("    can't open \'%s\' file for append\n", commandData);
+        continue;
+      }
+
+      PoeTextAppend append;
+      PoeStatus status = poeAppendText(&text, file, &append);
+
+      fclose(file);
+
+      // generator is updated by appended strings only, before they are merged into sorted ones
+      if (generatorIsInit && (!POE_CHECK(status) || !POE_CHECK(poeOneginGeneratorAppend(&generator, &append)))) {
+        poeDestroyOneginGenerator(&generator);
+        generatorIsInit = POE_FALSE;
+      }
+
+      if (!POE_CHECK(status)) {
+        printf("    error during text file appending occured\n");
+        continue;
+      }
+
+      if (compareFn != NULL && !POE_CHECK(poeSortTextAppended(&text, append.firstStringIndex, compareFn)))
+        printf("    error during appended strings merge\n");
+
+      printf("    %zu string(s) appended\n", text.stringCount - append.firstStringIndex);
+      continue;
+    }
+
+    if (strcmp(buffer, command.stats) == 0) {
+      if (!POE_STATS_ENABLED) {
+        printf("    instrumentation is compiled out (POE_STATS_DISABLED is defined)\n");
+        continue;
+      }
+
+      if (strcmp(commandData, command.statsReset) == 0) {
+        poeStatsReset();
+        printf("    statistics reset\n");
+        continue;
+      }
+
+      PoeStats stats;
+
+      poeStatsGet(&stats);
+      printf("    comparator calls       %llu\n", (unsigned long long)stats.comparisonCount);
+      printf("    bytes scanned          %llu\n", (unsigned long long)stats.comparedByteCount);
+      printf("    partitions             %llu (max depth %llu)\n",
+        (unsigned long long)stats.partitionCount, (unsigned long long)stats.maxPartitionDepth
+      );
+      printf("    allocations            %llu (%llu bytes)\n",
+        (unsigned long long)stats.allocationCount, (unsigned long long)stats.allocatedByteCount
+      );
+      for (size_t i = 0; i < POE_STATS_PHASE_COUNT; i++)
+        printf("    %-8s phase         %.3f ms in %llu call(s)\n",
+          poeStatsGetPhaseName((PoeStatsPhase)i), stats.phaseTime[i] * 1000.0, (unsigned long long)stats.phaseCallCount[i]
+        );
+      continue;
+    }
+
+    if (strcmp(buffer, command.stat) == 0) {
+      PoeTextReader reader;
+
+      if (fopen_s(&file, commandData, "rb") != 0 || file == NULL) {
+        printf("    can't open \'%s\' file for statistics\n", commandData);
+        continue;
+      }
+
+      if (!POE_CHECK(poeOpenTextReader(file, 0, 0, &reader))) {
+        printf("    error during text reader initialization\n");
+        fclose(file);
+        continue;
+      }
+
+      size_t stringCount = 0, emptyStringCount = 0, maxStringLength = 0, totalLength = 0;
+      PoeText batch;
+      PoeStatus status;
+
+      // text is read by batches, so file may be larger than memory
+      while (POE_CHECK(status = poeTextReaderNext(&reader, &batch)) && batch.stringCount != 0) {
+        for (size_t i = 0; i < batch.stringCount; i++) {
+          const size_t length = batch.strings[i].end - batch.strings[i].begin;
+
+          emptyStringCount += (length == 0);
+          totalLength += length;
+          if (length > maxStringLength)
+            maxStringLength = length;
+        }
+        stringCount += batch.stringCount;
+      }
+
+      if (POE_CHECK(status)) {
+        printf("    strings:               %zu\n", stringCount);
+        printf("    empty strings:         %zu\n", emptyStringCount);
+        printf("    total string length:   %zu\n", totalLength);
+        printf("    maximal string length: %zu\n", maxStringLength);
+      } else {
+        printf("    error during \'%s\' file reading\n", commandData);
+      }
+
+      poeCloseTextReader(&reader);
+      fclose(file);
+      continue;
+    }
+
+    if (strcmp(buffer, command.threads) == 0) {
+      unsigned int count = 0;
+
+      if (sscanf_s(commandData, "%u", &count) != 1) {
+        printf("    invalid thread count: \'%s\'\n", commandData);
+        continue;
+      }
+
+      threadCount = count == 0 ? poeParallelGetHardwareThreadCount() : count;
+      printf("    using %zu thread(s)\n", threadCount);
+      continue;
+    }
+
+    if (strcmp(buffer, command.seed) == 0) {
+      unsigned long long seed = 0;
+
+      if (sscanf_s(commandData, "%llu", &seed) != 1) {
+        printf("    invalid seed: \'%s\'\n", commandData);
+        continue;
+      }
+
+      poeRandomSeed(&seedRandom, (uint64_t)seed, 0);
+      printf("    stanza seed set to %llu\n", seed);
+      continue;
+    }
+
+    if (strcmp(buffer, command.select) == 0) {
+      if (!textIsInit) {
+        printf("    no text to select strings from\n");
+        continue;
+      }
+
+      // split order, count and optional 'last' flag
+      const char *countData = cliSplitString((char *)commandData);
+      const char *flag = cliSplitString((char *)countData);
+      PoeStringCompareFn compareFn = NULL;
+      unsigned int count = 0;
+
+      if (strcmp(commandData, command.sortForward) == 0) {
+        compareFn = poeCompareFromStart;
+      } else if (strcmp(commandData, command.sortReverse) == 0) {
+        compareFn = poeCompareFromEnd;
+      } else {
+        printf("    unknown sorting method: \'%s\'\n", commandData);
+        continue;
+      }
+
+      if (sscanf_s(countData, "%u", &count) != 1) {
+        printf("    invalid string count: \'%s\'\n", countData);
+        continue;
+      }
+
+      size_t first = 0;
+      size_t last = count < text.stringCount ? count : text.stringCount;
+
+      if (strcmp(flag, command.selectLast) == 0) {
+        // largest strings are ones after (stringCount - count) smallest
+        PoeText tail = text;
+
+        first = text.stringCount - last;
+        last = text.stringCount;
+
+        poeSelectText(&text, first, compareFn);
+        tail.strings += first;
+        tail.stringCount -= first;
+        poeSortText(&tail, compareFn);
+      } else {
+        poePartialSortText(&text, count, compareFn);
+      }
+
+      for (size_t i = first; i < last; i++)
+        printf("    %.*s\n", (int)(text.strings[i].end - text.strings[i].begin), text.strings[i].begin);
+      continue;
+    }
+
+    if (strcmp(buffer, command.externalSort) == 0) {
+      // split order, input and output file names and optional parameters
+      const char *inputName = cliSplitString((char *)commandData);
+      const char *outputName = cliSplitString((char *)inputName);
+      const char *parameters = cliSplitString((char *)outputName);
+      PoeStringCompareFn compareFn = NULL;
+
+      if (strcmp(commandData, command.sortForward) == 0) {
+        compareFn = poeCompareFromStart;
+      } else if (strcmp(commandData, command.sortReverse) == 0) {
+        compareFn = poeCompareFromEnd;
+      } else {
+        printf("    unknown sorting method: \'%s\'\n", commandData);
+        continue;
+      }
+
+      unsigned int memoryBudgetKb = 0, fanIn = 0;
+      sscanf_s(parameters, "%u %u", &memoryBudgetKb, &fanIn);
+
+      const PoeExternalSortParams params = {
+        .memoryBudget = (size_t)memoryBudgetKb << 10,
+        .fanIn = fanIn,
+      };
+
+      FILE *input = NULL, *output = NULL;
+
+      if (fopen_s(&input, inputName, "rb") != 0 || input == NULL) {
+        printf("    can't open \'%s\' file for external sort\n", inputName);
+        continue;
+      }
+
+      if (fopen_s(&output, outputName, "wb") != 0 || output == NULL) {
+        printf("    can't open \'%s\' file for sorted text write\n", outputName);
+        fclose(input);
+        continue;
+      }
+
+      PoeExternalSortStat stat;
+
+      if (POE_CHECK(poeSortFileExternal(input, output, compareFn, &params, &stat)))
+        printf("    %zu strings sorted: %zu run(s), %zu merge pass(es)\n", stat.stringCount, stat.runCount, stat.mergePassCount);
+      else
+        printf("    error during \'%s\' file external sort\n", inputName);
+
+      fclose(output);
+      fclose(input);
+      continue;
+    }
+
+    if (strcmp(buffer, command.encoding) == 0) {
+      static const PoeEncoding encodings[] = {POE_ENCODING_CP1251, POE_ENCODING_KOI8R, POE_ENCODING_LATIN1};
+      PoeBool found = POE_FALSE;
+
+      for (size_t i = 0; i < sizeof(encodings) / sizeof(encodings[0]); i++)
+        if (strcmp(commandData, poeCompareGetEncodingName(encodings[i])) == 0) {
+          poeCompareSetEncoding(encodings[i]);
+          found = POE_TRUE;
+        }
+
+      if (!found) {
+        printf("    unknown encoding: \'%s\'\n", commandData);
+        continue;
+      }
+
+      // generator endings depend on encoding
+      if (generatorIsInit) {
+        poeDestroyOneginGenerator(&generator);
+        generatorIsInit = POE_FALSE;
+      }
+
+      printf("    using %s encoding\n", poeCompareGetEncodingName(poeCompareGetEncoding()));
+      continue;
+    }
+
+    if (strcmp(buffer, command.bench) == 0) {
+      // split benchmark name and its parameters
+      const char *benchData = cliSplitString((char *)commandData);
+
+      if (strcmp(commandData, command.benchLoad) == 0) {
+        if (!poeBenchLoad(stdout, benchData, 8))
+          printf("    error during \'%s\' file load benchmark\n", benchData);
+      } else if (strcmp(commandData, command.benchScan) == 0) {
+        if (!poeBenchScan(stdout, benchData, 8))
+          printf("    error during \'%s\' file scan benchmark\n", benchData);
+      } else if (strcmp(commandData, command.benchSort) == 0) {
+        if (!poeBenchSort(stdout, benchData, 4))
+          printf("    error during \'%s\' file sort benchmark\n", benchData);
+      } else if (strcmp(commandData, command.benchParallelSort) == 0) {
+        if (!poeBenchSortParallel(stdout, benchData, 4))
+          printf("    error during \'%s\' file parallel sort benchmark\n", benchData);
+      } else if (strcmp(commandData, command.benchAdversarial) == 0) {
+        unsigned int count = 0;
+
+        if (sscanf_s(benchData, "%u", &count) != 1)
+          printf("    invalid string count: \'%s\'\n", benchData);
+        else if (!poeBenchSortAdversarial(stdout, count, 4))
+          printf("    error during adversarial sort benchmark\n");
+      } else if (strcmp(commandData, command.benchArray) == 0) {
+        unsigned int count = 0;
+
+        if (sscanf_s(benchData, "%u", &count) != 1)
+          printf("    invalid push count: \'%s\'\n", benchData);
+        else if (!poeBenchArray(stdout, count, 4))
+          printf("    error during array push benchmark\n");
+      } else if (strcmp(commandData, command.benchSuite) == 0) {
+        // split output file name, maximal line count and corpus file names
+        const char *countData = cliSplitString((char *)benchData);
+        const char *fileData = cliSplitString((char *)countData);
+        const char *fileNames[64];
+        size_t fileCount = 0;
+        unsigned long long maxCount = 0;
+        FILE *out = NULL;
+
+        while (*fileData != '\0' && fileCount < sizeof(fileNames) / sizeof(fileNames[0])) {
+          fileNames[fileCount++] = fileData;
+          fileData = cliSplitString((char *)fileData);
+        }
+
+        if (sscanf_s(countData, "%llu", &maxCount) != 1)
+          printf("    invalid maximal line count: '%s'\n", countData);
+        else if (fopen_s(&out, benchData, "w") != 0 || out == NULL)
+          printf("    can't open '%s' file for benchmark results\n", benchData);
+        else {
+          if (!poeBenchSortSuite(out, (size_t)maxCount, fileNames, fileCount, 3))
+            printf("    error during sort benchmark suite\n");
+          fclose(out);
+        }
+      } else {
+        printf("    unknown benchmark: \'%s\'\n", commandData);
+      }
+      continue;
+    }
+
     if (strcmp(buffer, command.help) == 0) {
       printf("    load file              %s <file name>\n"           , command.load);
-      printf("    generate stanza        %s\n"                       , command.stanza);
-      printf("    sort with comparator   %s <\'%s\'|\'%s\'|\'%s\'>\n", command.sort, command.sortInitial, command.sortForward, command.sortReverse);
+      printf("    load file by mapping   %s <file name>\n"           , command.map);
+      printf("    append file to text    %s <file name> [\'%s\'|\'%s\' (order text is sorted in)]\n",
+        command.append, command.sortForward, command.sortReverse
+      );
+      printf("    stream file statistics %s <file name>\n"           , command.stat);
+      printf("    instrumentation stats  %s [\'%s\']\n"               , command.stats, command.statsReset);
+      printf("    generate stanzas       %s [count] [output file]\n" , command.stanza);
+      printf("    set stanza random seed %s <seed>\n"                , command.seed);
+      printf("    save generator         %s <file name>\n"           , command.generatorSave);
+      printf("    load saved generator   %s <file name>\n"           , command.generatorLoad);
+      printf("    sort with comparator   %s <\'%s\'|\'%s\'|\'%s\'> [\'%s\'|\'%s\'|\'%s\'|\'%s\'|\'%s\'|\'%s\'|\'%s\'|\'%s\']\n",
+        command.sort, command.sortInitial, command.sortForward, command.sortReverse,
+        command.sortQsort, command.sortStd, command.sortKeyed, command.sortRadix, command.sortRhyme, command.sortParallel,
+        command.sortHoare, command.sortPacked
+      );
       printf("    write to file          %s <file name>\n"           , command.write);
+      printf("    select first strings   %s <\'%s\'|\'%s\'> <count> [\'%s\']\n",
+        command.select, command.sortForward, command.sortReverse, command.selectLast
+      );
+      printf("    external file sort     %s <\'%s\'|\'%s\'> <input file> <output file> [memory budget, KB] [fan-in]\n",
+        command.externalSort, command.sortForward, command.sortReverse
+      );
+      printf("    set thread count       %s <count (0 for all cores)>\n", command.threads);
+      printf("    set text encoding      %s <\'%s\'|\'%s\'|\'%s\'>\n", command.encoding,
+        poeCompareGetEncodingName(POE_ENCODING_CP1251), poeCompareGetEncodingName(POE_ENCODING_KOI8R), poeCompareGetEncodingName(POE_ENCODING_LATIN1)
+      );
+      printf("    benchmark loaders      %s %s <file name>\n"        , command.bench, command.benchLoad);
+      printf("    benchmark line scan    %s %s <file name>\n"        , command.bench, command.benchScan);
+      printf("    benchmark sort engines %s %s <file name>\n"        , command.bench, command.benchSort);
+      printf("    benchmark parallel     %s %s <file name>\n"        , command.bench, command.benchParallelSort);
+      printf("    benchmark adversarial  %s %s <string count>\n"     , command.bench, command.benchAdversarial);
+      printf("    benchmark sort suite   %s %s <JSON output file> <max line count> [corpus files...]\n", command.bench, command.benchSuite);
+      printf("    benchmark array push   %s %s <push count>\n"       , command.bench, command.benchArray);
       printf("\n");
       printf("    show this menu         %s\n"                       , command.help);
       printf("    quit from program      %s\n"                       , command.quit);
@@ -165,27 +643,75 @@ main( void ) {
       }
 
       if (!generatorIsInit)
-        if (POE_CHECK(poeCreateOneginGenerator(&text, &generator))) {
+        if (POE_CHECK(poeCreateOneginGenerator(&text, &generator, NULL))) {
           generatorIsInit = POE_TRUE;
         } else {
           printf("    error during text generator initialization\n");
           continue;
         }
 
-      const PoeString *stanzaBuffer[14] = {NULL};
-      if (!POE_CHECK(poeOneginGenerateStanza(&generator, stanzaBuffer))) {
+      // split stanza count and optional output file name
+      const char *outputName = cliSplitString((char *)commandData);
+      unsigned int stanzaCount = 1;
+
+      if (*commandData != '\0' && (sscanf_s(commandData, "%u", &stanzaCount) != 1 || stanzaCount == 0)) {
+        printf("    invalid stanza count: \'%s\'\n", commandData);
+        continue;
+      }
+
+      FILE *output = stdout;
+
+      if (*outputName != '\0' && (fopen_s(&output, outputName, "wb") != 0 || output == NULL)) {
+        printf("    can't open \'%s\' file for stanza write\n", outputName);
+        continue;
+      }
+
+      PoeString *stanzaBuffer = (PoeString *)calloc((size_t)stanzaCount * POE_STANZA_LINE_COUNT, sizeof(PoeString));
+      if (stanzaBuffer == NULL) {
+        printf("    can't allocate buffer for %u stanza(s)\n", stanzaCount);
+        if (output != stdout)
+          fclose(output);
+        continue;
+      }
+
+      PoeOneginGeneratorStatus status = poeOneginGenerateStanzas(&generator, stanzaCount, poeRandomNext(&seedRandom), threadCount, stanzaBuffer);
+
+      if (status == POE_ONEGIN_GENERATOR_STATUS_NO_STANZAS)
+        printf("    text contains no stanzas to generate from\n");
+      else if (!POE_CHECK(status))
         printf("    error during stanza generation occured\n");
+      else if (!POE_CHECK(poeWriteStanzas(output, stanzaBuffer, stanzaCount, &outputBuffer)))
+        printf("    error during stanza write occured\n");
+
+      free(stanzaBuffer);
+      if (output != stdout)
+        fclose(output);
+      continue;
+    }
+
+    if (strcmp(buffer, command.generatorSave) == 0) {
+      if (!textIsInit) {
+        printf("    no text to build generator from\n");
         continue;
       }
 
-      for (size_t i = 0; i < 14; i++)
-        printf("%s\n", stanzaBuffer[i]->begin);
+      if (!generatorIsInit) {
+        if (POE_CHECK(poeCreateOneginGenerator(&text, &generator, NULL))) {
+          generatorIsInit = POE_TRUE;
+        } else {
+          printf("    error during text generator initialization\n");
+          continue;
+        }
+      }
+
+      if (!POE_CHECK(poeSaveOneginGenerator(&generator, commandData)))
+        printf("    error during generator save to \'%s\' file\n", commandData);
       continue;
     }
 
-    if (strcmp(buffer, command.sort) == 0) {
+    if (strcmp(buffer, command.generatorLoad) == 0) {
       if (!textIsInit) {
-        printf("    no text to write\n");
+        printf("    no text to load generator for\n");
         continue;
       }
 
@@ -194,12 +720,37 @@ main( void ) {
         generatorIsInit = POE_FALSE;
       }
 
+      PoeStatus status = poeLoadOneginGenerator(&text, commandData, &generator);
+
+      if (status == POE_STATUS_BAD_FORMAT)
+        printf("    \'%s\' is not generator snapshot of current text\n", commandData);
+      else if (!POE_CHECK(status))
+        printf("    error during generator load from \'%s\' file\n", commandData);
+      else
+        generatorIsInit = POE_TRUE;
+      continue;
+    }
+
+    if (strcmp(buffer, command.sort) == 0) {
+      if (!textIsInit) {
+        printf("    no text to write\n");
+        continue;
+      }
+
+      // generator keeps line offsets in initial order, so it stays valid after text reordering
+
+      // split sorting method and engine
+      const char *engine = cliSplitString((char *)commandData);
       PoeStringCompareFn compareFn = NULL;
 
       if (strcmp(commandData, command.sortForward) == 0) {
         compareFn = poeCompareFromStart;
       } else if (strcmp(commandData, command.sortReverse) == 0) {
         compareFn = poeCompareFromEnd;
+
+        // rhyme sort is the fastest one for reverse order
+        if (engine[0] == '\0')
+          engine = command.sortRhyme;
       } else if (strcmp(commandData, command.sortInitial) == 0) {
         compareFn = poeCompareInitialOrder;
       } else {
@@ -207,7 +758,44 @@ main( void ) {
         continue;
       }
 
-      poeSortText(&text, compareFn);
+      if (engine[0] == '\0')
+        engine = command.sortQsort;
+
+      if (strcmp(engine, command.sortQsort) == 0 || compareFn == poeCompareInitialOrder) {
+        poeSortText(&text, compareFn);
+      } else if (strcmp(engine, command.sortStd) == 0) {
+        poeSortTextStd(&text, compareFn);
+      } else if (strcmp(engine, command.sortHoare) == 0) {
+        poeSortTextHoare(&text, compareFn);
+      } else if (strcmp(engine, command.sortPacked) == 0) {
+        if (!POE_CHECK(poeSortTextPacked(&text, compareFn == poeCompareFromStart ? POE_KEY_ORDER_FORWARD : POE_KEY_ORDER_REVERSE)))
+          printf("    error during packed sort\n");
+      } else if (strcmp(engine, command.sortParallel) == 0) {
+        poeSortTextParallel(&text, compareFn, threadCount);
+      } else if (strcmp(engine, command.sortRhyme) == 0) {
+        if (compareFn != poeCompareFromEnd)
+          printf("    \'%s\' engine supports \'%s\' order only\n", command.sortRhyme, command.sortReverse);
+        else if (!POE_CHECK(poeSortTextRhyme(&text)))
+          printf("    error during rhyme sort\n");
+      } else if (strcmp(engine, command.sortKeyed) == 0 || strcmp(engine, command.sortRadix) == 0) {
+        const PoeKeyOrder order = compareFn == poeCompareFromStart ? POE_KEY_ORDER_FORWARD : POE_KEY_ORDER_REVERSE;
+        PoeTextKeys keys;
+
+        if (!POE_CHECK(poeCreateTextKeys(&text, &keys))) {
+          printf("    error during sort key building\n");
+          continue;
+        }
+
+        PoeStatus status = strcmp(engine, command.sortKeyed) == 0
+          ? poeSortTextKeyed(&text, &keys, order)
+          : poeSortTextRadix(&text, &keys, order);
+
+        if (!POE_CHECK(status))
+          printf("    error during %s sort\n", engine);
+        poeDestroyTextKeys(&keys);
+      } else {
+        printf("    unknown sorting engine: \'%s\'\n", engine);
+      }
       continue;
     }
 
@@ -242,6 +830,8 @@ main( void ) {
     poeDestroyOneginGenerator(&generator);
   if (textIsInit)
     poeDestroyText(&text);
+  poeDestroyArena(&sessionArena);
+  poeDestroyOutputBuffer(&outputBuffer);
 
   return 0;
 } // main function end
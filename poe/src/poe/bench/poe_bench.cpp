@@ -0,0 +1,1265 @@
+/**
+ * @file   poe/bench/poe_bench.cpp
+ * @author tiot2
+ * @brief  Poem processor benchmark implementation module
+ */
+
+#include "poe_bench.h"
+
+#include <atomic>
+
+// dynamic array (baseline of array benchmark)
+#include <darr/darr.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#endif
+
+double POE_API
+poeBenchGetTime( void ) {
+  struct timespec ts = {0};
+
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+} // poeBenchGetTime function end
+
+PoeBool POE_API
+poeBenchGetMemoryUsage( PoeBenchMemoryUsage *const dst ) {
+  assert(dst != NULL);
+
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS_EX counters = {0};
+
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS *)&counters, sizeof(counters)))
+    return POE_FALSE;
+
+  dst->resident = counters.WorkingSetSize;
+  dst->private_ = counters.PrivateUsage;
+#else
+  FILE *statm = fopen("/proc/self/statm", "r");
+
+  if (statm == NULL)
+    return POE_FALSE;
+
+  size_t total = 0, resident = 0, shared = 0;
+  int readCount = fscanf(statm, "%zu %zu %zu", &total, &resident, &shared);
+  fclose(statm);
+
+  if (readCount != 3)
+    return POE_FALSE;
+
+  const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+  dst->resident = resident * pageSize;
+  dst->private_ = (resident - shared) * pageSize;
+#endif
+
+  return POE_TRUE;
+} // poeBenchGetMemoryUsage function end
+
+/// text loader benchmark result representation structure
+typedef struct __PoeBenchLoadResult {
+  double    minTime;         ///< minimal load time (in seconds)
+  double    averageTime;     ///< average load time (in seconds)
+  long long residentDelta;   ///< resident memory growth after load (in bytes)
+  long long privateDelta;    ///< private memory growth after load (in bytes)
+  size_t    stringCount;     ///< count of loaded strings
+} PoeBenchLoadResult;
+
+/**
+ * @brief single loader benchmark function
+ * 
+ * @param fileName    file to load
+ * @param mapped      POE_TRUE to use poeParseTextMapped, POE_FALSE to use poeParseText
+ * @param useArena    POE_TRUE to load text to arena, POE_FALSE to load it to heap
+ * @param repeatCount count of loads
+ * @param dst         result destination
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static PoeBool
+poeBenchLoadSingle( const char *const fileName, const PoeBool mapped, const PoeBool useArena, const size_t repeatCount, PoeBenchLoadResult *const dst ) {
+  memset(dst, 0, sizeof(PoeBenchLoadResult));
+  dst->minTime = 1e30;
+
+  for (size_t i = 0; i < repeatCount; i++) {
+    PoeText text = {0};
+    PoeArena arena;
+    PoeBenchMemoryUsage before = {0}, after = {0};
+    PoeStatus status = POE_STATUS_OK;
+
+    poeCreateArena(&arena, 0);
+    poeBenchGetMemoryUsage(&before);
+    double startTime = poeBenchGetTime();
+
+    if (mapped) {
+      status = poeParseTextMapped(fileName, &text, useArena ? &arena : NULL);
+    } else {
+      FILE *file = NULL;
+
+      if (fopen_s(&file, fileName, "rb") != 0 || file == NULL)
+        return POE_FALSE;
+      status = poeParseText(file, &text, useArena ? &arena : NULL);
+      fclose(file);
+    }
+
+    double time = poeBenchGetTime() - startTime;
+
+    if (!POE_CHECK(status)) {
+      poeDestroyArena(&arena);
+      return POE_FALSE;
+    }
+
+    poeBenchGetMemoryUsage(&after);
+
+    if (time < dst->minTime)
+      dst->minTime = time;
+    dst->averageTime += time / (double)repeatCount;
+
+    // keep maximal growth, as freed memory may be reused by next loads
+    if ((long long)(after.resident - before.resident) > dst->residentDelta)
+      dst->residentDelta = (long long)(after.resident - before.resident);
+    if ((long long)(after.private_ - before.private_) > dst->privateDelta)
+      dst->privateDelta = (long long)(after.private_ - before.private_);
+    dst->stringCount = text.stringCount;
+
+    poeDestroyText(&text);
+    poeDestroyArena(&arena);
+  }
+
+  return POE_TRUE;
+} // poeBenchLoadSingle function end
+
+PoeBool POE_API
+poeBenchLoad( FILE *const out, const char *const fileName, const size_t repeatCount ) {
+  assert(out != NULL);
+  assert(fileName != NULL);
+  assert(repeatCount > 0);
+
+  static const struct {
+    const char *name;     ///< loader name
+    PoeBool     mapped;   ///< mapped loader flag
+    PoeBool     useArena; ///< arena loader flag
+  } loaders[] = {
+    {"poeParseText",       POE_FALSE, POE_FALSE},
+    {"poeParseText/arena", POE_FALSE, POE_TRUE },
+    {"poeParseTextMapped", POE_TRUE,  POE_FALSE},
+  };
+
+  // warm up file cache
+  {
+    PoeBenchLoadResult warmup;
+
+    if (!poeBenchLoadSingle(fileName, POE_FALSE, POE_FALSE, 1, &warmup))
+      return POE_FALSE;
+  }
+
+  fprintf(out, "%-20s %12s %12s %14s %14s %12s\n", "loader", "min, ms", "avg, ms", "resident, KB", "private, KB", "strings");
+
+  for (size_t i = 0; i < sizeof(loaders) / sizeof(loaders[0]); i++) {
+    PoeBenchLoadResult result;
+
+    if (!poeBenchLoadSingle(fileName, loaders[i].mapped, loaders[i].useArena, repeatCount, &result))
+      return POE_FALSE;
+
+    fprintf(out, "%-20s %12.3f %12.3f %14lld %14lld %12zu\n",
+      loaders[i].name,
+      result.minTime * 1000.0,
+      result.averageTime * 1000.0,
+      result.residentDelta / 1024,
+      result.privateDelta / 1024,
+      result.stringCount
+    );
+  }
+
+  return POE_TRUE;
+} // poeBenchLoad function end
+
+/**
+ * @brief scan results identity checking function
+ * 
+ * @param lhsBuffer destination buffer of first scan
+ * @param lhs       first scan result
+ * @param rhsBuffer destination buffer of second scan
+ * @param rhs       second scan result
+ * 
+ * @return POE_TRUE if scanned data and string ranges are byte-identical, POE_FALSE otherwise
+ */
+static PoeBool
+poeBenchScanIsIdentical( const char *const lhsBuffer, const PoeScanResult *const lhs, const char *const rhsBuffer, const PoeScanResult *const rhs ) {
+  if (lhs->size != rhs->size || lhs->stringCount != rhs->stringCount || memcmp(lhsBuffer, rhsBuffer, lhs->size) != 0)
+    return POE_FALSE;
+
+  for (size_t i = 0; i < lhs->stringCount; i++)
+    if (lhs->strings[i].begin - lhsBuffer != rhs->strings[i].begin - rhsBuffer || lhs->strings[i].end - lhsBuffer != rhs->strings[i].end - rhsBuffer)
+      return POE_FALSE;
+
+  return POE_TRUE;
+} // poeBenchScanIsIdentical function end
+
+PoeBool POE_API
+poeBenchScan( FILE *const out, const char *const fileName, const size_t repeatCount ) {
+  assert(out != NULL);
+  assert(fileName != NULL);
+  assert(repeatCount > 0);
+
+  PoeFileMapping mapping = {0};
+
+  if (!poeMapFile(fileName, &mapping))
+    return POE_FALSE;
+
+  // scalar kernel result every other kernel one is compared with
+  char *buffer = (char *)malloc(mapping.size + 1);
+  char *referenceBuffer = (char *)malloc(mapping.size + 1);
+  const char *const data = mapping.data != NULL ? mapping.data : "";
+  const PoeScanKernel initialKernel = poeScanGetKernel();
+  PoeScanResult reference = {0};
+
+  poeScanSetKernel(POE_SCAN_KERNEL_SCALAR);
+
+  if (buffer == NULL || referenceBuffer == NULL || !POE_CHECK(poeScanLines(referenceBuffer, data, mapping.size, &reference, NULL))) {
+    poeScanSetKernel(initialKernel);
+    free(buffer);
+    free(referenceBuffer);
+    poeUnmapFile(&mapping);
+    return POE_FALSE;
+  }
+
+  const PoeScanKernel kernels[] = {POE_SCAN_KERNEL_SCALAR, POE_SCAN_KERNEL_SSE2, POE_SCAN_KERNEL_AVX2};
+  PoeBool ok = POE_TRUE;
+
+  fprintf(out, "%-8s %12s %12s %12s %10s\n", "kernel", "min, ms", "MB/s", "strings", "identical");
+
+  for (size_t i = 0; ok && i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+    if (!poeScanIsKernelSupported(kernels[i]))
+      continue;
+    poeScanSetKernel(kernels[i]);
+
+    double minTime = 1e30;
+    size_t stringCount = 0;
+    PoeBool isIdentical = POE_TRUE;
+
+    for (size_t r = 0; r < repeatCount; r++) {
+      PoeScanResult scan = {0};
+      double startTime = poeBenchGetTime();
+
+      if (!POE_CHECK(poeScanLines(buffer, data, mapping.size, &scan, NULL))) {
+        ok = POE_FALSE;
+        break;
+      }
+
+      double time = poeBenchGetTime() - startTime;
+
+      if (time < minTime)
+        minTime = time;
+      stringCount = scan.stringCount;
+      isIdentical = isIdentical && poeBenchScanIsIdentical(referenceBuffer, &reference, buffer, &scan);
+      free(scan.strings);
+    }
+
+    if (ok)
+      fprintf(out, "%-8s %12.3f %12.1f %12zu %10s\n",
+        poeScanGetKernelName(kernels[i]),
+        minTime * 1000.0,
+        (double)mapping.size / minTime / (1024.0 * 1024.0),
+        stringCount,
+        isIdentical ? "yes" : "NO"
+      );
+    ok = ok && isIdentical;
+  }
+
+  poeScanSetKernel(initialKernel);
+  free(reference.strings);
+  free(referenceBuffer);
+  free(buffer);
+  poeUnmapFile(&mapping);
+
+  return ok;
+} // poeBenchScan function end
+
+/// sort engine
+typedef enum __PoeBenchSortEngine {
+  POE_BENCH_SORT_ENGINE_QSORT,  ///< poeSortText
+  POE_BENCH_SORT_ENGINE_HOARE,  ///< poeSortTextHoare
+  POE_BENCH_SORT_ENGINE_FNPTR,  ///< poeSortTextT with compare function pointer calls (not inlined comparator)
+  POE_BENCH_SORT_ENGINE_STD,    ///< poeSortTextStd
+  POE_BENCH_SORT_ENGINE_PACKED, ///< poeSortTextPacked
+  POE_BENCH_SORT_ENGINE_KEYED,  ///< poeCreateTextKeys + poeSortTextKeyed
+  POE_BENCH_SORT_ENGINE_RADIX,  ///< poeCreateTextKeys + poeSortTextRadix
+  POE_BENCH_SORT_ENGINE_RHYME,  ///< poeSortTextRhyme (reverse order only)
+} PoeBenchSortEngine;
+
+/// count of comparisons performed by poeBenchCountingCompare
+static size_t poeBenchComparisonCount = 0;
+
+/// compare function called by poeBenchCountingCompare
+static PoeStringCompareFn poeBenchCountedCompareFn = poeCompareFromStart;
+
+/**
+ * @brief comparisons counting compare function
+ * 
+ * @param lhs left hand side
+ * @param rhs right hand side
+ * 
+ * @return poeBenchCountedCompareFn result
+ */
+static PoeOrdering POE_API
+poeBenchCountingCompare( const PoeString *const lhs, const PoeString *const rhs ) {
+  poeBenchComparisonCount++;
+  return poeBenchCountedCompareFn(lhs, rhs);
+} // poeBenchCountingCompare function end
+
+/// count of comparisons performed by poeBenchAtomicCountingCompare
+static std::atomic<size_t> poeBenchAtomicComparisonCount = 0;
+
+/**
+ * @brief comparisons on several threads counting compare function
+ * 
+ * @param lhs left hand side
+ * @param rhs right hand side
+ * 
+ * @return poeBenchCountedCompareFn result
+ */
+static PoeOrdering POE_API
+poeBenchAtomicCountingCompare( const PoeString *const lhs, const PoeString *const rhs ) {
+  poeBenchAtomicComparisonCount.fetch_add(1, std::memory_order_relaxed);
+  return poeBenchCountedCompareFn(lhs, rhs);
+} // poeBenchAtomicCountingCompare function end
+
+/**
+ * @brief single sort engine benchmark function
+ * 
+ * @param text          text to sort
+ * @param initialOrder  text strings in initial order
+ * @param engine        sort engine
+ * @param order         sort order
+ * @param repeatCount   count of sorts
+ * @param minTime       minimal sort time (output)
+ * @param minPrepareTime minimal preparation (key building) time (output)
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static PoeBool
+poeBenchSortSingle(
+  PoeText *const text,
+  const PoeString *const initialOrder,
+  const PoeBenchSortEngine engine,
+  const PoeKeyOrder order,
+  const size_t repeatCount,
+  double *const minTime,
+  double *const minPrepareTime
+) {
+  const PoeStringCompareFn compareFn = order == POE_KEY_ORDER_FORWARD ? poeCompareFromStart : poeCompareFromEnd;
+
+  *minTime = 1e30;
+  *minPrepareTime = 1e30;
+
+  for (size_t i = 0; i < repeatCount; i++) {
+    memcpy(text->strings, initialOrder, text->stringCount * sizeof(PoeString));
+
+    PoeTextKeys keys = {0};
+    double startTime = poeBenchGetTime();
+    double prepareTime = 0.0;
+
+    switch (engine) {
+    case POE_BENCH_SORT_ENGINE_QSORT:
+      poeSortText(text, compareFn);
+      break;
+
+    case POE_BENCH_SORT_ENGINE_HOARE:
+      poeSortTextHoare(text, compareFn);
+      break;
+
+    case POE_BENCH_SORT_ENGINE_FNPTR:
+      poeSortTextT(text, PoeCompareFnFunctor {compareFn});
+      break;
+
+    case POE_BENCH_SORT_ENGINE_STD:
+      poeSortTextStd(text, compareFn);
+      break;
+
+    case POE_BENCH_SORT_ENGINE_RHYME:
+      if (!POE_CHECK(poeSortTextRhyme(text)))
+        return POE_FALSE;
+      break;
+
+    case POE_BENCH_SORT_ENGINE_PACKED:
+      if (!POE_CHECK(poeSortTextPacked(text, order)))
+        return POE_FALSE;
+      break;
+
+    case POE_BENCH_SORT_ENGINE_KEYED:
+    case POE_BENCH_SORT_ENGINE_RADIX: {
+      if (!POE_CHECK(poeCreateTextKeys(text, &keys)))
+        return POE_FALSE;
+      prepareTime = poeBenchGetTime() - startTime;
+
+      PoeStatus status = engine == POE_BENCH_SORT_ENGINE_KEYED
+        ? poeSortTextKeyed(text, &keys, order)
+        : poeSortTextRadix(text, &keys, order);
+
+      if (!POE_CHECK(status)) {
+        poeDestroyTextKeys(&keys);
+        return POE_FALSE;
+      }
+      break;
+    }
+    }
+
+    double time = poeBenchGetTime() - startTime;
+
+    if (engine == POE_BENCH_SORT_ENGINE_KEYED || engine == POE_BENCH_SORT_ENGINE_RADIX)
+      poeDestroyTextKeys(&keys);
+
+    if (time < *minTime)
+      *minTime = time;
+    if (prepareTime < *minPrepareTime)
+      *minPrepareTime = prepareTime;
+  }
+
+  return POE_TRUE;
+} // poeBenchSortSingle function end
+
+/**
+ * @brief sort engine comparisons counting function
+ * 
+ * @param text          text to sort
+ * @param initialOrder  text strings in initial order
+ * @param engine        sort engine
+ * @param order         sort order
+ * 
+ * @return count of compare function calls, SIZE_MAX if engine does not sort by compare function
+ */
+static size_t
+poeBenchSortCountComparisons(
+  PoeText *const text,
+  const PoeString *const initialOrder,
+  const PoeBenchSortEngine engine,
+  const PoeKeyOrder order
+) {
+  memcpy(text->strings, initialOrder, text->stringCount * sizeof(PoeString));
+  poeBenchComparisonCount = 0;
+  poeBenchCountedCompareFn = order == POE_KEY_ORDER_FORWARD ? poeCompareFromStart : poeCompareFromEnd;
+
+  switch (engine) {
+  case POE_BENCH_SORT_ENGINE_QSORT:
+  case POE_BENCH_SORT_ENGINE_FNPTR:
+    poeSortText(text, poeBenchCountingCompare);
+    return poeBenchComparisonCount;
+
+  case POE_BENCH_SORT_ENGINE_HOARE:
+    poeSortTextHoare(text, poeBenchCountingCompare);
+    return poeBenchComparisonCount;
+
+  case POE_BENCH_SORT_ENGINE_STD:
+    poeSortTextStd(text, poeBenchCountingCompare);
+    return poeBenchComparisonCount;
+
+  default:
+    return SIZE_MAX;
+  }
+} // poeBenchSortCountComparisons function end
+
+PoeBool POE_API
+poeBenchSort( FILE *const out, const char *const fileName, const size_t repeatCount ) {
+  assert(out != NULL);
+  assert(fileName != NULL);
+  assert(repeatCount > 0);
+
+  static const struct {
+    const char         * name;   ///< engine name
+    PoeBenchSortEngine   engine; ///< engine
+  } engines[] = {
+    {"qsort" , POE_BENCH_SORT_ENGINE_QSORT },
+    {"hoare" , POE_BENCH_SORT_ENGINE_HOARE },
+    {"fnptr" , POE_BENCH_SORT_ENGINE_FNPTR },
+    {"std"   , POE_BENCH_SORT_ENGINE_STD   },
+    {"packed", POE_BENCH_SORT_ENGINE_PACKED},
+    {"keyed" , POE_BENCH_SORT_ENGINE_KEYED },
+    {"radix" , POE_BENCH_SORT_ENGINE_RADIX },
+    {"rhyme" , POE_BENCH_SORT_ENGINE_RHYME },
+  };
+
+  static const struct {
+    const char  * name;  ///< order name
+    PoeKeyOrder   order; ///< order
+  } orders[] = {
+    {"forward", POE_KEY_ORDER_FORWARD},
+    {"reverse", POE_KEY_ORDER_REVERSE},
+  };
+
+  PoeText text = {0};
+
+  if (!POE_CHECK(poeParseTextMapped(fileName, &text, NULL)))
+    return POE_FALSE;
+
+  PoeString *initialOrder = (PoeString *)calloc(text.stringCount, sizeof(PoeString));
+
+  if (initialOrder == NULL) {
+    poeDestroyText(&text);
+    return POE_FALSE;
+  }
+
+  // sort from random order
+  poeShuffleText(&text, text.stringCount * 2);
+  memcpy(initialOrder, text.strings, text.stringCount * sizeof(PoeString));
+
+  PoeBool ok = POE_TRUE;
+
+  fprintf(out, "%-8s %-8s %12s %14s\n", "order", "engine", "total, ms", "prepare, ms");
+
+  for (size_t oi = 0; ok && oi < sizeof(orders) / sizeof(orders[0]); oi++) {
+    for (size_t ei = 0; ok && ei < sizeof(engines) / sizeof(engines[0]); ei++) {
+      double time, prepareTime;
+
+      if (engines[ei].engine == POE_BENCH_SORT_ENGINE_RHYME && orders[oi].order != POE_KEY_ORDER_REVERSE)
+        continue;
+
+      if ((ok = poeBenchSortSingle(&text, initialOrder, engines[ei].engine, orders[oi].order, repeatCount, &time, &prepareTime)))
+        fprintf(out, "%-8s %-8s %12.3f %14.3f\n", orders[oi].name, engines[ei].name, time * 1000.0, prepareTime * 1000.0);
+    }
+  }
+
+  free(initialOrder);
+  poeDestroyText(&text);
+
+  return ok;
+} // poeBenchSort function end
+
+PoeBool POE_API
+poeBenchSortParallel( FILE *const out, const char *const fileName, const size_t repeatCount ) {
+  assert(out != NULL);
+  assert(fileName != NULL);
+  assert(repeatCount > 0);
+
+  static const size_t threadCounts[] = {1, 2, 4, 8, 16};
+
+  static const struct {
+    const char         * name;      ///< order name
+    PoeStringCompareFn   compareFn; ///< order compare function
+  } orders[] = {
+    {"forward", poeCompareFromStart},
+    {"reverse", poeCompareFromEnd  },
+  };
+
+  PoeText text = {0};
+
+  if (!POE_CHECK(poeParseTextMapped(fileName, &text, NULL)))
+    return POE_FALSE;
+
+  PoeString *initialOrder = (PoeString *)calloc(text.stringCount, sizeof(PoeString));
+
+  if (initialOrder == NULL) {
+    poeDestroyText(&text);
+    return POE_FALSE;
+  }
+
+  poeShuffleText(&text, text.stringCount * 2);
+  memcpy(initialOrder, text.strings, text.stringCount * sizeof(PoeString));
+
+  fprintf(out, "%-8s %-8s %12s %10s\n", "order", "threads", "min, ms", "speedup");
+
+  for (size_t oi = 0; oi < sizeof(orders) / sizeof(orders[0]); oi++) {
+    double baseTime = 1e30;
+
+    for (size_t r = 0; r < repeatCount; r++) {
+      memcpy(text.strings, initialOrder, text.stringCount * sizeof(PoeString));
+
+      double startTime = poeBenchGetTime();
+      poeSortText(&text, orders[oi].compareFn);
+      double time = poeBenchGetTime() - startTime;
+
+      if (time < baseTime)
+        baseTime = time;
+    }
+
+    fprintf(out, "%-8s %-8s %12.3f %10.2f\n", orders[oi].name, "qsort", baseTime * 1000.0, 1.0);
+
+    for (size_t ti = 0; ti < sizeof(threadCounts) / sizeof(threadCounts[0]); ti++) {
+      double minTime = 1e30;
+
+      for (size_t r = 0; r < repeatCount; r++) {
+        memcpy(text.strings, initialOrder, text.stringCount * sizeof(PoeString));
+
+        double startTime = poeBenchGetTime();
+        poeSortTextParallel(&text, orders[oi].compareFn, threadCounts[ti]);
+        double time = poeBenchGetTime() - startTime;
+
+        if (time < minTime)
+          minTime = time;
+      }
+
+      fprintf(out, "%-8s %-8zu %12.3f %10.2f\n", orders[oi].name, threadCounts[ti], minTime * 1000.0, baseTime / minTime);
+    }
+  }
+
+  free(initialOrder);
+  poeDestroyText(&text);
+
+  return POE_TRUE;
+} // poeBenchSortParallel function end
+
+/// adversarial sort input pattern enumeration
+typedef enum __PoeBenchSortPattern {
+  POE_BENCH_SORT_PATTERN_RANDOM,     ///< random strings
+  POE_BENCH_SORT_PATTERN_SORTED,     ///< already sorted strings
+  POE_BENCH_SORT_PATTERN_REVERSED,   ///< strictly descending strings
+  POE_BENCH_SORT_PATTERN_EQUAL,      ///< equal strings
+  POE_BENCH_SORT_PATTERN_SEPARATORS, ///< random strings interleaved with empty (stanza separator) ones
+  POE_BENCH_SORT_PATTERN_FEW_UNIQUE, ///< 16 distinct strings
+  POE_BENCH_SORT_PATTERN_ORGAN_PIPE, ///< ascending then descending strings
+  POE_BENCH_SORT_PATTERN_SAWTOOTH,   ///< 16 ascending runs
+  POE_BENCH_SORT_PATTERN_NOISY,      ///< sorted strings with 1% of random swaps
+} PoeBenchSortPattern;
+
+/// length of adversarial input string
+#define POE_BENCH_PATTERN_STRING_LENGTH 8
+
+/// poeSortTextHoare is quadratic on organ pipe input, so it is skipped for larger inputs
+#define POE_BENCH_HOARE_MAX_STRING_COUNT 16384
+
+/**
+ * @brief text on all hardware threads sorting function
+ * 
+ * @param text      text to sort
+ * @param compareFn compare function
+ */
+static void POE_API
+poeBenchSortTextParallel( PoeText *const text, const PoeStringCompareFn compareFn ) {
+  poeSortTextParallel(text, compareFn, 0);
+} // poeBenchSortTextParallel function end
+
+/**
+ * @brief adversarial sort input generation function
+ * 
+ * @param text        text to fill strings of (string buffer and array must hold stringCount strings)
+ * @param pattern     input pattern
+ * 
+ * @note string values are encoded as POE_BENCH_PATTERN_STRING_LENGTH lowercase letters, so
+ *       forward string order matches value order
+ */
+static void
+poeBenchGeneratePattern( PoeText *const text, const PoeBenchSortPattern pattern ) {
+  const size_t count = text->stringCount;
+  const size_t runLength = count / 16 + 1;
+
+  for (size_t i = 0; i < count; i++) {
+    size_t value = 0;
+    PoeBool empty = POE_FALSE;
+
+    switch (pattern) {
+    case POE_BENCH_SORT_PATTERN_RANDOM     : value = (size_t)rand() * RAND_MAX + rand();                   break;
+    case POE_BENCH_SORT_PATTERN_SORTED     :
+    case POE_BENCH_SORT_PATTERN_NOISY      : value = i;                                                    break;
+    case POE_BENCH_SORT_PATTERN_REVERSED   : value = count - i;                                            break;
+    case POE_BENCH_SORT_PATTERN_EQUAL      : value = 0;                                                    break;
+    case POE_BENCH_SORT_PATTERN_SEPARATORS : value = (size_t)rand() * RAND_MAX + rand(); empty = i % 2 == 0; break;
+    case POE_BENCH_SORT_PATTERN_FEW_UNIQUE : value = rand() % 16;                                          break;
+    case POE_BENCH_SORT_PATTERN_ORGAN_PIPE : value = i < count / 2 ? i : count - i;                        break;
+    case POE_BENCH_SORT_PATTERN_SAWTOOTH   : value = i % runLength;                                        break;
+    }
+
+    char *const begin = text->stringBuffer + i * POE_BENCH_PATTERN_STRING_LENGTH;
+
+    for (size_t c = POE_BENCH_PATTERN_STRING_LENGTH; c > 0; c--) {
+      begin[c - 1] = (char)('a' + value % 26);
+      value /= 26;
+    }
+
+    text->strings[i].begin = begin;
+    text->strings[i].end = empty ? begin : begin + POE_BENCH_PATTERN_STRING_LENGTH;
+  }
+
+  if (pattern == POE_BENCH_SORT_PATTERN_NOISY)
+    for (size_t i = 0; i < count / 100; i++) {
+      const size_t lhs = ((size_t)rand() * RAND_MAX + rand()) % count;
+      const size_t rhs = ((size_t)rand() * RAND_MAX + rand()) % count;
+      const PoeString tmp = text->strings[lhs];
+
+      text->strings[lhs] = text->strings[rhs];
+      text->strings[rhs] = tmp;
+    }
+} // poeBenchGeneratePattern function end
+
+PoeBool POE_API
+poeBenchSortAdversarial( FILE *const out, const size_t stringCount, const size_t repeatCount ) {
+  assert(out != NULL);
+  assert(repeatCount > 0);
+
+  static const struct {
+    const char          * name;    ///< pattern name
+    PoeBenchSortPattern   pattern; ///< pattern
+  } patterns[] = {
+    {"random"    , POE_BENCH_SORT_PATTERN_RANDOM    },
+    {"sorted"    , POE_BENCH_SORT_PATTERN_SORTED    },
+    {"reversed"  , POE_BENCH_SORT_PATTERN_REVERSED  },
+    {"equal"     , POE_BENCH_SORT_PATTERN_EQUAL     },
+    {"separators", POE_BENCH_SORT_PATTERN_SEPARATORS},
+    {"few unique", POE_BENCH_SORT_PATTERN_FEW_UNIQUE},
+    {"organ pipe", POE_BENCH_SORT_PATTERN_ORGAN_PIPE},
+    {"sawtooth"  , POE_BENCH_SORT_PATTERN_SAWTOOTH  },
+    {"noisy"     , POE_BENCH_SORT_PATTERN_NOISY     },
+  };
+
+  static const struct {
+    const char         * name;                                   ///< engine name
+    void (POE_API *sortFn)( PoeText *, PoeStringCompareFn );     ///< engine sort function
+    PoeStringCompareFn   compareFn;                              ///< comparisons counting compare function
+    size_t               maxStringCount;                         ///< maximal count of strings engine is run on (0 if unlimited)
+  } engines[] = {
+    {"qsort"   , poeSortText             , poeBenchCountingCompare      , 0                               },
+    {"hoare"   , poeSortTextHoare        , poeBenchCountingCompare      , POE_BENCH_HOARE_MAX_STRING_COUNT},
+    {"std"     , poeSortTextStd          , poeBenchCountingCompare      , 0                               },
+    {"parallel", poeBenchSortTextParallel, poeBenchAtomicCountingCompare, 0                               },
+  };
+
+  if (stringCount < 2)
+    return POE_FALSE;
+
+  PoeText text = {0};
+
+  text.stringCount = stringCount;
+  text.stringBuffer = (char *)calloc(stringCount, POE_BENCH_PATTERN_STRING_LENGTH);
+  text.strings = (PoeString *)calloc(stringCount, sizeof(PoeString));
+
+  PoeString *initialOrder = (PoeString *)calloc(stringCount, sizeof(PoeString));
+
+  if (text.stringBuffer == NULL || text.strings == NULL || initialOrder == NULL) {
+    free(text.stringBuffer);
+    free(text.strings);
+    free(initialOrder);
+    return POE_FALSE;
+  }
+
+  fprintf(out, "%-12s %-8s %12s %16s\n", "input", "engine", "min, ms", "comparisons");
+
+  for (size_t pi = 0; pi < sizeof(patterns) / sizeof(patterns[0]); pi++) {
+    poeBenchGeneratePattern(&text, patterns[pi].pattern);
+    memcpy(initialOrder, text.strings, stringCount * sizeof(PoeString));
+
+    for (size_t ei = 0; ei < sizeof(engines) / sizeof(engines[0]); ei++) {
+      double minTime = 1e30;
+
+      if (engines[ei].maxStringCount != 0 && stringCount > engines[ei].maxStringCount) {
+        fprintf(out, "%-12s %-8s %12s %16s\n", patterns[pi].name, engines[ei].name, "skipped", "-");
+        continue;
+      }
+
+      for (size_t r = 0; r < repeatCount; r++) {
+        memcpy(text.strings, initialOrder, stringCount * sizeof(PoeString));
+        poeBenchComparisonCount = 0;
+        poeBenchAtomicComparisonCount = 0;
+        poeBenchCountedCompareFn = poeCompareFromStart;
+
+        double startTime = poeBenchGetTime();
+        engines[ei].sortFn(&text, engines[ei].compareFn);
+        double time = poeBenchGetTime() - startTime;
+
+        if (time < minTime)
+          minTime = time;
+      }
+
+      fprintf(out, "%-12s %-8s %12.3f %16zu\n", patterns[pi].name, engines[ei].name, minTime * 1000.0,
+        poeBenchComparisonCount + poeBenchAtomicComparisonCount.load()
+      );
+    }
+  }
+
+  free(initialOrder);
+  free(text.strings);
+  free(text.stringBuffer);
+
+  return POE_TRUE;
+} // poeBenchSortAdversarial function end
+
+/**
+ * @brief splitmix64 pseudo-random number generation function
+ * 
+ * @param state generator state
+ * 
+ * @return pseudo-random number
+ */
+static uint64_t
+poeBenchRandom( uint64_t *const state ) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+} // poeBenchRandom function end
+
+PoeStatus POE_API
+poeBenchGenerateCorpus( const PoeBenchCorpusParams *const params, PoeText *const dst ) {
+  assert(params != NULL);
+  assert(dst != NULL);
+  assert(params->minLength <= params->maxLength);
+
+  // cp1251 words of random letters separated by spaces and punctuation
+  static const char punctuation[] = ",.;:!?-";
+  uint64_t state = params->seed;
+  const size_t stringCount = params->stringCount;
+  const size_t lengthRange = params->maxLength - params->minLength + 1;
+
+  memset(dst, 0, sizeof(PoeText));
+
+  // line structure (duplicates and lengths) and characters are generated from separate streams,
+  // so first pass replays structure only to compute buffer size
+  uint64_t characterState = params->seed ^ 0x5851F42D4C957F2Dull;
+  size_t bufferSize = 0;
+
+  for (size_t i = 0; i < stringCount; i++) {
+    const PoeBool duplicate = i > 0 && (double)(poeBenchRandom(&state) >> 11) / (double)(1ull << 53) < params->duplicateRatio;
+
+    bufferSize += duplicate ? (poeBenchRandom(&state), 0) : params->minLength + poeBenchRandom(&state) % lengthRange;
+  }
+
+  dst->stringBuffer = (char *)malloc(bufferSize + 1);
+  dst->strings = (PoeString *)calloc(stringCount + 1, sizeof(PoeString));
+
+  if (dst->stringBuffer == NULL || dst->strings == NULL) {
+    free(dst->stringBuffer);
+    free(dst->strings);
+    memset(dst, 0, sizeof(PoeText));
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  char *iter = dst->stringBuffer;
+
+  state = params->seed;
+  for (size_t i = 0; i < stringCount; i++) {
+    const PoeBool duplicate = i > 0 && (double)(poeBenchRandom(&state) >> 11) / (double)(1ull << 53) < params->duplicateRatio;
+
+    if (duplicate) {
+      dst->strings[i] = dst->strings[poeBenchRandom(&state) % i];
+      continue;
+    }
+
+    const size_t length = params->minLength + poeBenchRandom(&state) % lengthRange;
+
+    dst->strings[i].begin = iter;
+
+    for (size_t c = 0; c < length; c++) {
+      const uint64_t r = poeBenchRandom(&characterState) % 64;
+
+      if (r < 48)
+        *iter++ = (char)(0xE0 + r % 32);
+      else if (r < 52)
+        *iter++ = (char)(0xC0 + r % 32);
+      else if (r < 60)
+        *iter++ = ' ';
+      else
+        *iter++ = punctuation[r % (sizeof(punctuation) - 1)];
+    }
+
+    dst->strings[i].end = iter;
+  }
+
+  *iter = '\0';
+  dst->stringCount = stringCount;
+
+  return POE_STATUS_OK;
+} // poeBenchGenerateCorpus function end
+
+/**
+ * @brief corpus sort benchmark results JSON writing function
+ * 
+ * @param out          file to write results to
+ * @param corpusName   corpus name (file name or "synthetic")
+ * @param params       synthetic corpus parameters (NULL for file corpus)
+ * @param text         corpus text
+ * @param repeatCount  count of sorts performed for each comparator and engine
+ * @param isFirst      POE_TRUE if no results were written before (input/output)
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static PoeBool
+poeBenchSortCorpus(
+  FILE *const out,
+  const char *const corpusName,
+  const PoeBenchCorpusParams *const params,
+  PoeText *const text,
+  const size_t repeatCount,
+  PoeBool *const isFirst
+) {
+  static const struct {
+    const char         * name;   ///< engine name
+    PoeBenchSortEngine   engine; ///< engine
+  } engines[] = {
+    {"qsort" , POE_BENCH_SORT_ENGINE_QSORT },
+    {"std"   , POE_BENCH_SORT_ENGINE_STD   },
+    {"packed", POE_BENCH_SORT_ENGINE_PACKED},
+    {"keyed" , POE_BENCH_SORT_ENGINE_KEYED },
+    {"radix" , POE_BENCH_SORT_ENGINE_RADIX },
+    {"rhyme" , POE_BENCH_SORT_ENGINE_RHYME },
+  };
+
+  static const struct {
+    const char  * name;  ///< order name
+    PoeKeyOrder   order; ///< order
+  } orders[] = {
+    {"forward", POE_KEY_ORDER_FORWARD},
+    {"reverse", POE_KEY_ORDER_REVERSE},
+  };
+
+  PoeString *initialOrder = (PoeString *)calloc(text->stringCount + 1, sizeof(PoeString));
+  PoeString *generatedOrder = (PoeString *)calloc(text->stringCount + 1, sizeof(PoeString));
+  size_t byteCount = 0;
+
+  if (initialOrder == NULL || generatedOrder == NULL) {
+    free(initialOrder);
+    free(generatedOrder);
+    return POE_FALSE;
+  }
+
+  for (size_t i = 0; i < text->stringCount; i++)
+    byteCount += text->strings[i].end - text->strings[i].begin + 1;
+
+  // file corpora are sorted from random order, synthetic ones are random already
+  if (params == NULL)
+    poeShuffleText(text, text->stringCount * 2);
+  memcpy(generatedOrder, text->strings, text->stringCount * sizeof(PoeString));
+
+  PoeBool ok = POE_TRUE;
+
+  for (size_t oi = 0; ok && oi < sizeof(orders) / sizeof(orders[0]); oi++) {
+    const PoeStringCompareFn compareFn = orders[oi].order == POE_KEY_ORDER_FORWARD ? poeCompareFromStart : poeCompareFromEnd;
+
+    // presorted prefix in current order
+    memcpy(text->strings, generatedOrder, text->stringCount * sizeof(PoeString));
+
+    if (params != NULL && params->presortedFraction > 0.0) {
+      PoeText presorted = *text;
+
+      presorted.stringCount = (size_t)(text->stringCount * params->presortedFraction);
+      poeSortText(&presorted, compareFn);
+    }
+    memcpy(initialOrder, text->strings, text->stringCount * sizeof(PoeString));
+
+    for (size_t ei = 0; ok && ei < sizeof(engines) / sizeof(engines[0]); ei++) {
+      double time, prepareTime;
+
+      if (engines[ei].engine == POE_BENCH_SORT_ENGINE_RHYME && orders[oi].order != POE_KEY_ORDER_REVERSE)
+        continue;
+
+      if (!(ok = poeBenchSortSingle(text, initialOrder, engines[ei].engine, orders[oi].order, repeatCount, &time, &prepareTime)))
+        break;
+
+      const size_t comparisonCount = poeBenchSortCountComparisons(text, initialOrder, engines[ei].engine, orders[oi].order);
+
+      fprintf(out, "%s\n    {\"corpus\": \"", *isFirst ? "" : ",");
+      for (const char *c = corpusName; *c != '\0'; c++)
+        fprintf(out, *c == '\\' || *c == '"' ? "\\%c" : "%c", *c);
+      fprintf(out, "\", \"lines\": %zu, \"bytes\": %zu", text->stringCount, byteCount);
+
+      if (params != NULL)
+        fprintf(out, ", \"duplicateRatio\": %g, \"minLength\": %zu, \"maxLength\": %zu, \"presortedFraction\": %g",
+          params->duplicateRatio, params->minLength, params->maxLength, params->presortedFraction
+        );
+
+      fprintf(out, ", \"order\": \"%s\", \"engine\": \"%s\", \"timeMs\": %.3f, \"prepareMs\": %.3f",
+        orders[oi].name, engines[ei].name, time * 1000.0, prepareTime * 1000.0
+      );
+
+      if (comparisonCount == SIZE_MAX)
+        fprintf(out, ", \"comparisons\": null");
+      else
+        fprintf(out, ", \"comparisons\": %zu", comparisonCount);
+
+      fprintf(out, ", \"bytesPerSecond\": %.0f}", time > 0.0 ? byteCount / time : 0.0);
+      fflush(out);
+      *isFirst = POE_FALSE;
+    }
+  }
+
+  free(generatedOrder);
+  free(initialOrder);
+
+  return ok;
+} // poeBenchSortCorpus function end
+
+PoeBool POE_API
+poeBenchSortSuite(
+  FILE *const out,
+  const size_t maxStringCount,
+  const char *const *const fileNames,
+  const size_t fileCount,
+  const size_t repeatCount
+) {
+  assert(out != NULL);
+  assert(fileNames != NULL || fileCount == 0);
+  assert(repeatCount > 0);
+
+  static const struct {
+    double duplicateRatio;    ///< duplicate line ratio
+    size_t minLength;         ///< minimal line length
+    size_t maxLength;         ///< maximal line length
+    double presortedFraction; ///< presorted line fraction
+  } variants[] = {
+    {0.0,  8,  60, 0.0}, // random lines
+    {0.5,  8,  60, 0.0}, // half of lines are duplicates
+    {0.0,  8,  60, 0.9}, // almost sorted
+    {0.0,  1,   8, 0.0}, // short lines
+    {0.0, 80, 240, 0.0}, // long lines
+  };
+
+  PoeBool ok = POE_TRUE;
+  PoeBool isFirst = POE_TRUE;
+
+  fprintf(out, "{\"benchmark\": \"sort\", \"repeatCount\": %zu, \"results\": [", repeatCount);
+
+  for (size_t stringCount = 1000; ok && stringCount <= maxStringCount && stringCount <= POE_BENCH_CORPUS_MAX_STRING_COUNT; stringCount *= 10)
+    for (size_t vi = 0; ok && vi < sizeof(variants) / sizeof(variants[0]); vi++) {
+      const PoeBenchCorpusParams params = {
+        .stringCount = stringCount,
+        .duplicateRatio = variants[vi].duplicateRatio,
+        .minLength = variants[vi].minLength,
+        .maxLength = variants[vi].maxLength,
+        .presortedFraction = variants[vi].presortedFraction,
+        .seed = stringCount * 31 + vi,
+      };
+      PoeText text;
+
+      if (!(ok = POE_CHECK(poeBenchGenerateCorpus(&params, &text))))
+        break;
+
+      ok = poeBenchSortCorpus(out, "synthetic", &params, &text, repeatCount, &isFirst);
+      poeDestroyText(&text);
+    }
+
+  for (size_t fi = 0; ok && fi < fileCount; fi++) {
+    PoeText text;
+
+    if (!(ok = POE_CHECK(poeParseTextMapped(fileNames[fi], &text, NULL))))
+      break;
+
+    ok = poeBenchSortCorpus(out, fileNames[fi], NULL, &text, repeatCount, &isFirst);
+    poeDestroyText(&text);
+  }
+
+  fprintf(out, "\n  ], \"ok\": %s}\n", ok ? "true" : "false");
+
+  return ok;
+} // poeBenchSortSuite function end
+
+/// array push benchmark container
+typedef enum __PoeBenchArrayContainer {
+  POE_BENCH_ARRAY_CONTAINER_DARR,      ///< darrPush
+  POE_BENCH_ARRAY_CONTAINER_PUSH,      ///< PoeArray::push with doubling growth
+  POE_BENCH_ARRAY_CONTAINER_PUSH_HALF, ///< PoeArray::push with one and a half growth
+  POE_BENCH_ARRAY_CONTAINER_APPEND,    ///< PoeArray::append by POE_BENCH_ARRAY_APPEND_CHUNK_SIZE elements
+} PoeBenchArrayContainer;
+
+/// count of elements appended at once by POE_BENCH_ARRAY_CONTAINER_APPEND container
+#define POE_BENCH_ARRAY_APPEND_CHUNK_SIZE 64
+
+/// size of arrays of small array benchmark (fits inline storage of PoeArray)
+#define POE_BENCH_ARRAY_SMALL_SIZE 8
+
+/**
+ * @brief benchmark element by index building functions
+ * 
+ * @param index element index
+ * @param dst   element (output)
+ */
+static inline void
+poeBenchArrayMakeElement( const size_t index, uint32_t *const dst ) {
+  *dst = (uint32_t)index;
+} // poeBenchArrayMakeElement function end
+
+static inline void
+poeBenchArrayMakeElement( const size_t index, PoeString *const dst ) {
+  dst->begin = (char *)index;
+  dst->end = (char *)index + 1;
+} // poeBenchArrayMakeElement function end
+
+/**
+ * @brief benchmark element checksum getting functions
+ * 
+ * @param element element
+ * 
+ * @return element checksum
+ */
+static inline size_t
+poeBenchArrayGetChecksum( const uint32_t *const element ) {
+  return *element;
+} // poeBenchArrayGetChecksum function end
+
+static inline size_t
+poeBenchArrayGetChecksum( const PoeString *const element ) {
+  return (size_t)element->end;
+} // poeBenchArrayGetChecksum function end
+
+/**
+ * @brief PoeArray filling function
+ * 
+ * @param array     empty array to fill
+ * @param size      count of elements to push
+ * @param useAppend POE_TRUE to append elements by chunks, POE_FALSE to push them one by one
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+template <typename Array, typename Element>
+static PoeBool
+poeBenchArrayFillTyped( Array *const array, const size_t size, const PoeBool useAppend ) {
+  if (!useAppend) {
+    for (size_t i = 0; i < size; i++) {
+      Element element;
+
+      poeBenchArrayMakeElement(i, &element);
+      if (!array->push(element))
+        return POE_FALSE;
+    }
+
+    return POE_TRUE;
+  }
+
+  Element chunk[POE_BENCH_ARRAY_APPEND_CHUNK_SIZE];
+
+  for (size_t i = 0; i < size; i += POE_BENCH_ARRAY_APPEND_CHUNK_SIZE) {
+    const size_t chunkSize = size - i < POE_BENCH_ARRAY_APPEND_CHUNK_SIZE ? size - i : POE_BENCH_ARRAY_APPEND_CHUNK_SIZE;
+
+    for (size_t k = 0; k < chunkSize; k++)
+      poeBenchArrayMakeElement(i + k, chunk + k);
+    if (!array->append(chunk, chunkSize))
+      return POE_FALSE;
+  }
+
+  return POE_TRUE;
+} // poeBenchArrayFillTyped function end
+
+/**
+ * @brief arrays filling function
+ * 
+ * @param container  container to fill
+ * @param arrayCount count of arrays to fill
+ * @param arraySize  count of elements to push to every array (at least 1)
+ * @param checksum   checksum of filled arrays (output, keeps pushes from being optimized out)
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+template <typename Element>
+static PoeBool
+poeBenchArrayFill( const PoeBenchArrayContainer container, const size_t arrayCount, const size_t arraySize, size_t *const checksum ) {
+  for (size_t a = 0; a < arrayCount; a++) {
+    switch (container) {
+    case POE_BENCH_ARRAY_CONTAINER_DARR: {
+      Element *array = (Element *)darrCreate(sizeof(Element), 0);
+
+      if (array == NULL)
+        return POE_FALSE;
+
+      for (size_t i = 0; i < arraySize; i++) {
+        Element element;
+
+        poeBenchArrayMakeElement(i, &element);
+
+        Element *const pushed = (Element *)darrPush(array, &element);
+
+        if (pushed == NULL) {
+          darrDestroy(array);
+          return POE_FALSE;
+        }
+        array = pushed;
+      }
+
+      *checksum += darrGetSize(array) + poeBenchArrayGetChecksum(array + arraySize - 1);
+      darrDestroy(array);
+      break;
+    }
+    case POE_BENCH_ARRAY_CONTAINER_PUSH:
+    case POE_BENCH_ARRAY_CONTAINER_APPEND: {
+      PoeArray<Element> array;
+
+      if (!poeBenchArrayFillTyped<PoeArray<Element>, Element>(&array, arraySize, container == POE_BENCH_ARRAY_CONTAINER_APPEND))
+        return POE_FALSE;
+
+      *checksum += array.count + poeBenchArrayGetChecksum(&array[arraySize - 1]);
+      break;
+    }
+    case POE_BENCH_ARRAY_CONTAINER_PUSH_HALF: {
+      PoeArray<Element, 16, PoeArrayGrowthHalf> array;
+
+      if (!poeBenchArrayFillTyped<PoeArray<Element, 16, PoeArrayGrowthHalf>, Element>(&array, arraySize, POE_FALSE))
+        return POE_FALSE;
+
+      *checksum += array.count + poeBenchArrayGetChecksum(&array[arraySize - 1]);
+      break;
+    }
+    }
+  }
+
+  return POE_TRUE;
+} // poeBenchArrayFill function end
+
+PoeBool POE_API
+poeBenchArray( FILE *const out, const size_t pushCount, const size_t repeatCount ) {
+  assert(out != NULL);
+  assert(repeatCount > 0);
+
+  static const struct {
+    const char             * name;      ///< container name
+    PoeBenchArrayContainer   container; ///< container
+  } containers[] = {
+    {"darrPush"       , POE_BENCH_ARRAY_CONTAINER_DARR     },
+    {"PoeArray push"  , POE_BENCH_ARRAY_CONTAINER_PUSH     },
+    {"PoeArray 1.5x"  , POE_BENCH_ARRAY_CONTAINER_PUSH_HALF},
+    {"PoeArray append", POE_BENCH_ARRAY_CONTAINER_APPEND   },
+  };
+
+  static const struct {
+    const char * name;                                                        ///< element type name
+    PoeBool   (* fillFn)( PoeBenchArrayContainer, size_t, size_t, size_t * ); ///< array filling function
+  } elements[] = {
+    {"uint32_t" , poeBenchArrayFill<uint32_t> },
+    {"PoeString", poeBenchArrayFill<PoeString>},
+  };
+
+  if (pushCount < POE_BENCH_ARRAY_SMALL_SIZE)
+    return POE_FALSE;
+
+  size_t checksum = 0;
+
+  fprintf(out, "%-10s %-16s %12s %12s %12s %12s\n", "element", "container", "large, ms", "Mpush/s", "small, ms", "Mpush/s");
+
+  for (size_t ei = 0; ei < sizeof(elements) / sizeof(elements[0]); ei++)
+    for (size_t ci = 0; ci < sizeof(containers) / sizeof(containers[0]); ci++) {
+      // single large array measures growth, many small ones measure creation and first pushes
+      double minTimes[2] = {1e30, 1e30};
+      const size_t arrayCounts[2] = {1, pushCount / POE_BENCH_ARRAY_SMALL_SIZE};
+      const size_t arraySizes[2] = {pushCount, POE_BENCH_ARRAY_SMALL_SIZE};
+
+      for (size_t r = 0; r < repeatCount; r++)
+        for (size_t k = 0; k < 2; k++) {
+          double startTime = poeBenchGetTime();
+
+          if (!elements[ei].fillFn(containers[ci].container, arrayCounts[k], arraySizes[k], &checksum))
+            return POE_FALSE;
+
+          double time = poeBenchGetTime() - startTime;
+
+          if (time < minTimes[k])
+            minTimes[k] = time;
+        }
+
+      fprintf(out, "%-10s %-16s %12.3f %12.1f %12.3f %12.1f\n",
+        elements[ei].name,
+        containers[ci].name,
+        minTimes[0] * 1000.0,
+        (double)pushCount / minTimes[0] / 1e6,
+        minTimes[1] * 1000.0,
+        (double)(arrayCounts[1] * arraySizes[1]) / minTimes[1] / 1e6
+      );
+    }
+
+  // every fill of same container and element gives same checksum, so it is printed to be used
+  fprintf(out, "checksum: %zu\n", checksum);
+
+  return POE_TRUE;
+} // poeBenchArray function end
+
+// poe_bench.cpp file end
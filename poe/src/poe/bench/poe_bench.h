@@ -0,0 +1,163 @@
+/**
+ * @file   poe/bench/poe_bench.h
+ * @author tiot2
+ * @brief  Poem processor benchmark declaration module
+ */
+
+#ifndef POE_BENCH_H_
+#define POE_BENCH_H_
+
+#include "../poe.h"
+#include "../poe_scan.h"
+
+/// process memory usage representation structure
+typedef struct __PoeBenchMemoryUsage {
+  size_t resident; ///< resident (working set) memory size in bytes
+  size_t private_; ///< process private memory size in bytes
+} PoeBenchMemoryUsage;
+
+/**
+ * @brief monotonic time getting function
+ * 
+ * @return current time (in seconds)
+ */
+double POE_API
+poeBenchGetTime( void );
+
+/**
+ * @brief process memory usage getting function
+ * 
+ * @param dst memory usage destination
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchGetMemoryUsage( PoeBenchMemoryUsage *dst );
+
+/**
+ * @brief text loaders (poeParseText and poeParseTextMapped) benchmark function
+ * 
+ * @param out         file to write benchmark results to
+ * @param fileName    name of file to load
+ * @param repeatCount count of loads performed by each loader
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchLoad( FILE *out, const char *fileName, size_t repeatCount );
+
+/**
+ * @brief text line scanning kernels benchmark function
+ * 
+ * @param out         file to write benchmark results to
+ * @param fileName    name of file to scan
+ * @param repeatCount count of scans performed by each kernel
+ * 
+ * @note every scan result is checked to be byte-identical (data and string ranges) to scalar kernel one
+ * 
+ * @return POE_TRUE if succeeded and all results are identical, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchScan( FILE *out, const char *fileName, size_t repeatCount );
+
+/**
+ * @brief text sort engines benchmark function
+ * 
+ * @param out         file to write benchmark results to
+ * @param fileName    name of file to sort
+ * @param repeatCount count of sorts performed by each engine
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchSort( FILE *out, const char *fileName, size_t repeatCount );
+
+/**
+ * @brief parallel sort speedup over poeSortText benchmark function
+ * 
+ * @param out         file to write benchmark results to
+ * @param fileName    name of file to sort
+ * @param repeatCount count of sorts performed for each thread count
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchSortParallel( FILE *out, const char *fileName, size_t repeatCount );
+
+/**
+ * @brief sort engines on adversarial (degenerate for quicksort) inputs benchmark function
+ * 
+ * @param out         file to write benchmark results to
+ * @param stringCount count of strings in generated inputs
+ * @param repeatCount count of sorts performed for each input and engine
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ * 
+ * @note inputs: random, sorted, reversed, all equal, stanza separators (half of strings are empty),
+ *       few unique, organ pipe, sawtooth and sorted with 1% of random swaps; engines: poeSortText,
+ *       poeSortTextHoare, poeSortTextStd and poeSortTextParallel on all hardware threads
+ */
+PoeBool POE_API
+poeBenchSortAdversarial( FILE *out, size_t stringCount, size_t repeatCount );
+
+/// maximal count of synthetic corpus lines benchmarked by poeBenchSortSuite
+#define POE_BENCH_CORPUS_MAX_STRING_COUNT ((size_t)100000000)
+
+/// synthetic corpus parameters representation structure
+typedef struct __PoeBenchCorpusParams {
+  size_t   stringCount;       ///< count of lines
+  double   duplicateRatio;    ///< probability of line to be copy of one of previous lines
+  size_t   minLength;         ///< minimal line length
+  size_t   maxLength;         ///< maximal line length
+  double   presortedFraction; ///< fraction of lines (from text beginning) given in sorted order
+  uint64_t seed;              ///< pseudo-random generator seed
+} PoeBenchCorpusParams;
+
+/**
+ * @brief synthetic cp1251 corpus generation function
+ * 
+ * @param params corpus parameters (presortedFraction is applied by benchmark, as it depends on order)
+ * @param dst    text to generate (must be destroyed by poeDestroyText)
+ * 
+ * @note lines are random cp1251 letters, spaces and punctuation; duplicate lines share characters
+ *       with their originals; same parameters give same corpus
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeBenchGenerateCorpus( const PoeBenchCorpusParams *params, PoeText *dst );
+
+/**
+ * @brief corpus-scale sort benchmark suite function
+ * 
+ * @param out            file to write JSON results to
+ * @param maxStringCount maximal count of synthetic corpus lines (corpora of 10^3, 10^4, ... lines are benchmarked)
+ * @param fileNames      names of real text files to benchmark
+ * @param fileCount      count of real text files
+ * @param repeatCount    count of sorts performed for each corpus, order and engine
+ * 
+ * @note for each corpus, order and engine minimal wall time, compare function call count
+ *       (null for engines not sorting by compare function) and bytes per second are reported
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchSortSuite( FILE *out, size_t maxStringCount, const char *const *fileNames, size_t fileCount, size_t repeatCount );
+
+/**
+ * @brief typed growable array (PoeArray) against darr push throughput benchmark function
+ * 
+ * @param out         file to write benchmark results to
+ * @param pushCount   count of elements pushed by each container (at least 8)
+ * @param repeatCount count of fills performed by each container
+ * 
+ * @note uint32_t and PoeString elements are pushed to single array and to arrays of 8 elements
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeBenchArray( FILE *out, size_t pushCount, size_t repeatCount );
+
+#endif // !defined(POE_BENCH_H_)
+
+// poe_bench.h file end
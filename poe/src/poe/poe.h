@@ -7,10 +7,25 @@
 #ifndef POE_H_
 #define POE_H_
 
+#include "poe_stats.h"
+#include "poe_arena.h"
+#include "poe_array.h"
 #include "poe_sort.h"
+#include "poe_sort_template.h"
+#include "poe_scan.h"
+#include "poe_parallel.h"
+#include "poe_random.h"
+#include "poe_reader.h"
+#include "poe_output.h"
+#include "poe_external.h"
+#include "poe_key.h"
+#include "poe_radix.h"
+#include "poe_packed.h"
+#include "poe_compact.h"
 #include "poe_generator.h"
 #include "poe_generator2.h"
 #include "poe_onegin_generator.h"
+#include "poe_snapshot.h"
 
 #endif // !defined(POE_H_)
 
@@ -0,0 +1,280 @@
+/**
+ * @file   poe/poe_arena.cpp
+ * @author tiot2
+ * @brief  Poem processor bump allocator implementation module
+ */
+
+#include "poe_arena.h"
+#include "poe_stats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+/// arena block header representation structure
+struct __PoeArenaBlock {
+  PoeArenaBlock * next; ///< previously reserved block
+  size_t          size; ///< block size (with header)
+};
+
+/// size of block header with alignment
+#define POE_ARENA_HEADER_SIZE ((sizeof(PoeArenaBlock) + POE_ARENA_ALIGNMENT - 1) & ~(POE_ARENA_ALIGNMENT - 1))
+
+/**
+ * @brief zeroed system memory reservation function
+ *
+ * @param size size of memory to reserve (multiple of POE_ARENA_BLOCK_ALIGNMENT)
+ *
+ * @return reserved memory (NULL if reservation failed)
+ */
+static void *
+poeArenaReserve( const size_t size ) {
+#ifdef _WIN32
+  return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+  void *const memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (memory == MAP_FAILED)
+    return NULL;
+
+#ifdef MADV_HUGEPAGE
+  // failure only means that system keeps small pages
+  madvise(memory, size, MADV_HUGEPAGE);
+#endif
+
+  return memory;
+#endif
+} // poeArenaReserve function end
+
+/**
+ * @brief system memory release function
+ *
+ * @param memory memory reserved by poeArenaReserve
+ * @param size   memory size
+ */
+static void
+poeArenaRelease( void *const memory, const size_t size ) {
+#ifdef _WIN32
+  (void)size;
+  VirtualFree(memory, 0, MEM_RELEASE);
+#else
+  munmap(memory, size);
+#endif
+} // poeArenaRelease function end
+
+/**
+ * @brief arena block adding function
+ *
+ * @param arena arena
+ * @param size  size of allocation block must fit (aligned)
+ *
+ * @note new block becomes current one, rest of previous one is not used anymore
+ *
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static PoeBool
+poeArenaAddBlock( PoeArena *const arena, const size_t size ) {
+  if (size > SIZE_MAX - POE_ARENA_HEADER_SIZE - POE_ARENA_BLOCK_ALIGNMENT)
+    return POE_FALSE;
+
+  size_t blockSize = (POE_ARENA_HEADER_SIZE + size + POE_ARENA_BLOCK_ALIGNMENT - 1) & ~(POE_ARENA_BLOCK_ALIGNMENT - 1);
+
+  if (blockSize < arena->blockSize)
+    blockSize = arena->blockSize;
+
+  PoeArenaBlock *const block = (PoeArenaBlock *)poeArenaReserve(blockSize);
+
+  if (block == NULL)
+    return POE_FALSE;
+
+  block->next = arena->block;
+  block->size = blockSize;
+
+  arena->block = block;
+  arena->cursor = (char *)block + POE_ARENA_HEADER_SIZE;
+  arena->clean = arena->cursor;
+  arena->end = (char *)block + blockSize;
+  arena->last = NULL;
+  arena->reservedSize += blockSize;
+
+  return POE_TRUE;
+} // poeArenaAddBlock function end
+
+/**
+ * @brief arena allocation size aligning function
+ *
+ * @param size size to align
+ * @param dst  aligned size (output)
+ *
+ * @return POE_TRUE if aligned size fits size_t, POE_FALSE otherwise
+ */
+static inline PoeBool
+poeArenaAlignSize( const size_t size, size_t *const dst ) {
+  if (size > SIZE_MAX - POE_ARENA_ALIGNMENT)
+    return POE_FALSE;
+
+  // zero-sized allocations get distinct addresses too
+  *dst = size == 0 ? POE_ARENA_ALIGNMENT : (size + POE_ARENA_ALIGNMENT - 1) & ~(POE_ARENA_ALIGNMENT - 1);
+  return POE_TRUE;
+} // poeArenaAlignSize function end
+
+/**
+ * @brief arena cursor moving function
+ *
+ * @param arena  arena
+ * @param cursor new cursor (within current block)
+ */
+static inline void
+poeArenaSetCursor( PoeArena *const arena, char *const cursor ) {
+  arena->cursor = cursor;
+
+  if (arena->clean < cursor)
+    arena->clean = cursor;
+} // poeArenaSetCursor function end
+
+void POE_API
+poeCreateArena( PoeArena *const arena, const size_t blockSize ) {
+  assert(arena != NULL);
+
+  memset(arena, 0, sizeof(PoeArena));
+
+  const size_t size = blockSize == 0 ? POE_ARENA_BLOCK_SIZE : blockSize;
+
+  arena->blockSize = size > SIZE_MAX / 2
+    ? POE_ARENA_BLOCK_SIZE
+    : (size + POE_ARENA_BLOCK_ALIGNMENT - 1) & ~(POE_ARENA_BLOCK_ALIGNMENT - 1);
+} // poeCreateArena function end
+
+/**
+ * @brief memory from arena taking function
+ *
+ * @param arena arena to take memory from (not NULL)
+ * @param size  size of memory to take
+ *
+ * @note doesn't count allocation, so public allocation functions count every call exactly once
+ *
+ * @return taken memory (NULL if failed)
+ */
+static void *
+poeArenaTake( PoeArena *const arena, const size_t size ) {
+  size_t alignedSize;
+
+  if (!poeArenaAlignSize(size, &alignedSize))
+    return NULL;
+
+  if ((size_t)(arena->end - arena->cursor) < alignedSize && !poeArenaAddBlock(arena, alignedSize))
+    return NULL;
+
+  char *const memory = arena->cursor;
+
+  poeArenaSetCursor(arena, memory + alignedSize);
+  arena->last = memory;
+
+  return memory;
+} // poeArenaTake function end
+
+void * POE_API
+poeArenaAllocate( PoeArena *const arena, const size_t size ) {
+  POE_STATS_ALLOCATION(size);
+
+  if (arena == NULL)
+    return malloc(size);
+
+  return poeArenaTake(arena, size);
+} // poeArenaAllocate function end
+
+void * POE_API
+poeArenaAllocateZeroed( PoeArena *const arena, const size_t count, const size_t size ) {
+  if (size != 0 && count > SIZE_MAX / size)
+    return NULL;
+
+  POE_STATS_ALLOCATION(count * size);
+
+  if (arena == NULL)
+    return calloc(count, size);
+
+  const char *const clean = arena->clean;
+  const PoeArenaBlock *const block = arena->block;
+  char *const memory = (char *)poeArenaTake(arena, count * size);
+
+  if (memory == NULL)
+    return NULL;
+
+  // only memory handed out before (and given back by shrinking) may be dirty
+  if (arena->block == block && memory < clean)
+    memset(memory, 0, (size_t)(clean - memory) < count * size ? (size_t)(clean - memory) : count * size);
+
+  return memory;
+} // poeArenaAllocateZeroed function end
+
+void * POE_API
+poeArenaReallocate( PoeArena *const arena, void *const memory, const size_t oldSize, const size_t newSize ) {
+  POE_STATS_ALLOCATION(newSize);
+
+  if (arena == NULL)
+    return realloc(memory, newSize);
+
+  if (memory == NULL)
+    return poeArenaTake(arena, newSize);
+
+  size_t alignedSize;
+
+  if (!poeArenaAlignSize(newSize, &alignedSize))
+    return NULL;
+
+  if (memory == arena->last && alignedSize <= (size_t)(arena->end - arena->last)) {
+    poeArenaSetCursor(arena, arena->last + alignedSize);
+    return memory;
+  }
+
+  // other allocations can't give memory back anyway
+  if (newSize <= oldSize)
+    return memory;
+
+  PoeArenaBlock *const block = arena->block;
+  const PoeBool isBlockOwner = memory == arena->last && (char *)memory == (char *)block + POE_ARENA_HEADER_SIZE;
+  void *const newMemory = poeArenaTake(arena, newSize);
+
+  if (newMemory == NULL)
+    return NULL;
+
+  memcpy(newMemory, memory, oldSize < newSize ? oldSize : newSize);
+
+  // block of single moved allocation (e.g. growing array) is not needed anymore; last allocation
+  // that doesn't fit its block always moves to new one, so block is next one of current
+  if (isBlockOwner) {
+    assert(arena->block->next == block);
+
+    arena->block->next = block->next;
+    arena->reservedSize -= block->size;
+    poeArenaRelease(block, block->size);
+  }
+
+  return newMemory;
+} // poeArenaReallocate function end
+
+void POE_API
+poeArenaFree( PoeArena *const arena, void *const memory ) {
+  if (arena == NULL)
+    free(memory);
+} // poeArenaFree function end
+
+void POE_API
+poeDestroyArena( PoeArena *const arena ) {
+  assert(arena != NULL);
+
+  PoeArenaBlock *block = arena->block;
+
+  while (block != NULL) {
+    PoeArenaBlock *const next = block->next;
+
+    poeArenaRelease(block, block->size);
+    block = next;
+  }
+
+  memset(arena, 0, sizeof(PoeArena));
+} // poeDestroyArena function end
+
+// poe_arena.cpp file end
@@ -0,0 +1,128 @@
+/**
+ * @file   poe/poe_arena.h
+ * @author tiot2
+ * @brief  Poem processor bump allocator declaration module
+ *
+ * Arena hands out memory from few large blocks reserved from the system, so text, its indices
+ * and generators built over it take few huge-page-friendly regions instead of many heap blocks,
+ * and the whole set is freed at once by poeDestroyArena. Memory of separate allocations is never
+ * freed before that. Every allocation function accepts NULL arena and falls back to heap then,
+ * so construction functions take arena as optional parameter.
+ *
+ * Growth that is not last allocation copies data and leaves old memory in arena until it is
+ * destroyed. Objects that grow in arena (appended text strings, compact text offsets, Onegin
+ * generator pairs) grow geometrically, so memory they leave behind is less than their current
+ * size: arena text takes up to about twice its size after appends. Exact-size growth would leave
+ * memory proportional to squared count of appends, so objects that are rebuilt or grow by other
+ * means (generator growth tables, CLI generator) are kept off arena.
+ */
+
+#ifndef POE_ARENA_H_
+#define POE_ARENA_H_
+
+#include "poe_core.h"
+
+/// default arena block size
+#define POE_ARENA_BLOCK_SIZE ((size_t)64 << 20)
+
+/// arena block size granularity (huge page size)
+#define POE_ARENA_BLOCK_ALIGNMENT ((size_t)2 << 20)
+
+/// arena allocation alignment
+#define POE_ARENA_ALIGNMENT ((size_t)16)
+
+/// arena block (declared in implementation module)
+typedef struct __PoeArenaBlock PoeArenaBlock;
+
+/**
+ * @brief arena representation structure
+ *
+ * @note arena is not thread-safe
+ */
+typedef struct __PoeArena {
+  PoeArenaBlock * block;        ///< current block (NULL if nothing was allocated yet)
+  char          * cursor;       ///< first free byte of current block
+  char          * clean;        ///< first byte of current block that was never handed out (so is still zero)
+  char          * end;          ///< current block end
+  char          * last;         ///< last allocation (NULL if there is none, may be resized in place)
+  size_t          blockSize;    ///< size of blocks to reserve
+  size_t          reservedSize; ///< total size of reserved blocks
+} PoeArena;
+
+/**
+ * @brief arena creation function
+ *
+ * @param arena     arena to create (must be destroyed by poeDestroyArena)
+ * @param blockSize size of blocks to reserve (0 for POE_ARENA_BLOCK_SIZE, rounded up to POE_ARENA_BLOCK_ALIGNMENT)
+ *
+ * @note blocks are reserved on first allocations, larger allocations get own blocks
+ */
+void POE_API
+poeCreateArena( PoeArena *arena, size_t blockSize );
+
+/**
+ * @brief memory allocation function
+ *
+ * @param arena arena to allocate from (NULL to allocate by malloc)
+ * @param size  size of memory to allocate
+ *
+ * @return allocated memory aligned to POE_ARENA_ALIGNMENT (NULL if allocation failed)
+ */
+void * POE_API
+poeArenaAllocate( PoeArena *arena, size_t size );
+
+/**
+ * @brief zeroed memory allocation function
+ *
+ * @param arena arena to allocate from (NULL to allocate by calloc)
+ * @param count count of elements to allocate
+ * @param size  element size
+ *
+ * @note memory of fresh blocks is zeroed by system already, so it is not touched
+ *
+ * @return allocated memory (NULL if allocation failed)
+ */
+void * POE_API
+poeArenaAllocateZeroed( PoeArena *arena, size_t count, size_t size );
+
+/**
+ * @brief memory reallocation function
+ *
+ * @param arena   arena memory was allocated from (NULL to reallocate by realloc)
+ * @param memory  memory to reallocate (may be NULL)
+ * @param oldSize memory size
+ * @param newSize size to reallocate memory to
+ *
+ * @note last allocation is resized in place while it fits current block, other ones are copied
+ *       on growth (old memory is not freed then, unless it is the only allocation of its block)
+ *       and kept as is on shrinking
+ *
+ * @return reallocated memory (NULL if reallocation failed, memory is kept then)
+ */
+void * POE_API
+poeArenaReallocate( PoeArena *arena, void *memory, size_t oldSize, size_t newSize );
+
+/**
+ * @brief memory freeing function
+ *
+ * @param arena  arena memory was allocated from (NULL to free by free)
+ * @param memory memory to free (may be NULL)
+ *
+ * @note arena memory is freed by poeDestroyArena only
+ */
+void POE_API
+poeArenaFree( PoeArena *arena, void *memory );
+
+/**
+ * @brief arena destruction function
+ *
+ * @param arena arena to destroy (zero-initialized arenas may be destroyed too)
+ *
+ * @note frees every arena allocation at once
+ */
+void POE_API
+poeDestroyArena( PoeArena *arena );
+
+#endif // !defined(POE_ARENA_H_)
+
+// poe_arena.h file end
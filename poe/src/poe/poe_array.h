@@ -0,0 +1,286 @@
+/**
+ * @file   poe/poe_array.h
+ * @author tiot2
+ * @brief  Poem processor typed growable array declaration module
+ *
+ * Typed replacement of darr for build paths: element type is known at compile time, so pushes
+ * are inlined stores instead of memcpy calls through element size, and first InlineCapacity
+ * elements are kept in array itself, so small arrays never touch heap. Trivially copyable
+ * elements are relocated by realloc, other ones are moved one by one.
+ */
+
+#ifndef POE_ARRAY_H_
+#define POE_ARRAY_H_
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "poe_core.h"
+#include "poe_arena.h"
+
+/// doubling growth policy
+struct PoeArrayGrowthDouble {
+  /**
+   * @brief new capacity computing operator
+   *
+   * @param capacity current capacity
+   * @param required required capacity (greater than current one)
+   *
+   * @return new capacity (at least required one)
+   */
+  inline size_t
+  operator()( const size_t capacity, const size_t required ) const {
+    const size_t grown = capacity > SIZE_MAX / 2 ? SIZE_MAX : capacity * 2;
+
+    return grown < required ? required : grown;
+  } // operator() end
+}; // struct PoeArrayGrowthDouble end
+
+/// one and a half growth policy (freed blocks may be reused by later growth)
+struct PoeArrayGrowthHalf {
+  /**
+   * @brief new capacity computing operator
+   *
+   * @param capacity current capacity
+   * @param required required capacity (greater than current one)
+   *
+   * @return new capacity (at least required one)
+   */
+  inline size_t
+  operator()( const size_t capacity, const size_t required ) const {
+    const size_t grown = capacity > SIZE_MAX / 3 * 2 ? SIZE_MAX : capacity + capacity / 2;
+
+    return grown < required ? required : grown;
+  } // operator() end
+}; // struct PoeArrayGrowthHalf end
+
+/**
+ * @brief typed growable array with inline storage
+ *
+ * @note first InlineCapacity elements are kept inline, GrowthPolicy computes new capacity
+ *       ('size_t operator()( size_t capacity, size_t required ) const'). Array refers to its own
+ *       storage while inline, so it is not copyable (but movable)
+ */
+template <typename Element, size_t InlineCapacity = 16, typename GrowthPolicy = PoeArrayGrowthDouble>
+struct PoeArray {
+  static_assert(InlineCapacity > 0, "inline capacity must be positive");
+
+  Element * elements; ///< elements (inline storage while they fit it)
+  size_t    count;    ///< count of elements
+  size_t    capacity; ///< count of elements array holds without relocation
+
+  alignas(Element) unsigned char inlineStorage[InlineCapacity * sizeof(Element)]; ///< inline element storage
+
+  /// empty array constructor
+  PoeArray( void ) : elements((Element *)inlineStorage), count(0), capacity(InlineCapacity) {
+  } // PoeArray constructor end
+
+  PoeArray( const PoeArray & ) = delete;
+  PoeArray & operator=( const PoeArray & ) = delete;
+
+  /**
+   * @brief move constructor
+   *
+   * @param other array to move elements of (left empty)
+   */
+  PoeArray( PoeArray &&other ) : elements((Element *)inlineStorage), count(0), capacity(InlineCapacity) {
+    if (!other.isInline()) {
+      elements = other.elements;
+      count = other.count;
+      capacity = other.capacity;
+    } else {
+      for (size_t i = 0; i < other.count; i++) {
+        new (elements + i) Element(std::move(other.elements[i]));
+        other.elements[i].~Element();
+      }
+      count = other.count;
+    }
+
+    other.elements = (Element *)other.inlineStorage;
+    other.count = 0;
+    other.capacity = InlineCapacity;
+  } // PoeArray move constructor end
+
+  /// destructor
+  ~PoeArray( void ) {
+    clear();
+
+    if (!isInline())
+      poeArenaFree(NULL, elements);
+  } // PoeArray destructor end
+
+  /**
+   * @brief inline storage usage checking function
+   *
+   * @return POE_TRUE if elements are stored inline, POE_FALSE if they are heap ones
+   */
+  inline PoeBool
+  isInline( void ) const {
+    return elements == (const Element *)inlineStorage;
+  } // isInline end
+
+  /**
+   * @brief capacity reserving function
+   *
+   * @param required count of elements array must hold without relocation
+   *
+   * @return POE_TRUE if succeeded, POE_FALSE if allocation failed (array is not changed then)
+   */
+  inline PoeBool
+  reserve( const size_t required ) {
+    return required <= capacity || relocate(required);
+  } // reserve end
+
+  /**
+   * @brief element pushing function
+   *
+   * @param element element to push (may be one of array elements)
+   *
+   * @return POE_TRUE if succeeded, POE_FALSE if allocation failed (array is not changed then)
+   */
+  inline PoeBool
+  push( const Element &element ) {
+    if (count == capacity) {
+      // element may be relocated with array ones
+      Element copy(element);
+
+      return push(std::move(copy));
+    }
+
+    new (elements + count) Element(element);
+    count++;
+
+    return POE_TRUE;
+  } // push end
+
+  /**
+   * @brief element by moving pushing function
+   *
+   * @param element element to push (must not be one of array elements)
+   *
+   * @return POE_TRUE if succeeded, POE_FALSE if allocation failed (array is not changed then)
+   */
+  inline PoeBool
+  push( Element &&element ) {
+    if (count == capacity && !relocate(count + 1))
+      return POE_FALSE;
+
+    new (elements + count) Element(std::move(element));
+    count++;
+
+    return POE_TRUE;
+  } // push end
+
+  /**
+   * @brief elements appending function
+   *
+   * @param source      elements to append (must not be array ones)
+   * @param sourceCount count of elements to append
+   *
+   * @note array grows once for all appended elements
+   *
+   * @return POE_TRUE if succeeded, POE_FALSE if allocation failed (array is not changed then)
+   */
+  PoeBool
+  append( const Element *const source, const size_t sourceCount ) {
+    if (sourceCount > SIZE_MAX - count || !reserve(count + sourceCount))
+      return POE_FALSE;
+
+    if constexpr (std::is_trivially_copyable_v<Element>) {
+      if (sourceCount != 0)
+        memcpy((void *)(elements + count), source, sourceCount * sizeof(Element));
+    } else {
+      for (size_t i = 0; i < sourceCount; i++)
+        new (elements + count + i) Element(source[i]);
+    }
+    count += sourceCount;
+
+    return POE_TRUE;
+  } // append end
+
+  /// elements removing function (capacity is kept)
+  inline void
+  clear( void ) {
+    if constexpr (!std::is_trivially_destructible_v<Element>)
+      for (size_t i = 0; i < count; i++)
+        elements[i].~Element();
+    count = 0;
+  } // clear end
+
+  /**
+   * @brief element accessing operator
+   *
+   * @param index element index
+   *
+   * @return element
+   */
+  inline Element &
+  operator[]( const size_t index ) {
+    assert(index < count);
+    return elements[index];
+  } // operator[] end
+
+  /**
+   * @brief constant element accessing operator
+   *
+   * @param index element index
+   *
+   * @return element
+   */
+  inline const Element &
+  operator[]( const size_t index ) const {
+    assert(index < count);
+    return elements[index];
+  } // operator[] end
+
+private:
+  /**
+   * @brief elements to larger storage relocation function
+   *
+   * @param required count of elements storage must hold
+   *
+   * @return POE_TRUE if succeeded, POE_FALSE if allocation failed (array is not changed then)
+   */
+  PoeBool
+  relocate( const size_t required ) {
+    const size_t newCapacity = GrowthPolicy()(capacity, required);
+
+    if (newCapacity < required || newCapacity > SIZE_MAX / sizeof(Element))
+      return POE_FALSE;
+
+    Element *newElements;
+
+    if constexpr (std::is_trivially_copyable_v<Element>) {
+      // heap elements may be extended in place
+      if (!isInline()) {
+        if ((newElements = (Element *)poeArenaReallocate(NULL, elements, capacity * sizeof(Element), newCapacity * sizeof(Element))) == NULL)
+          return POE_FALSE;
+      } else {
+        if ((newElements = (Element *)poeArenaAllocate(NULL, newCapacity * sizeof(Element))) == NULL)
+          return POE_FALSE;
+        memcpy((void *)newElements, elements, count * sizeof(Element));
+      }
+    } else {
+      if ((newElements = (Element *)poeArenaAllocate(NULL, newCapacity * sizeof(Element))) == NULL)
+        return POE_FALSE;
+
+      for (size_t i = 0; i < count; i++) {
+        new (newElements + i) Element(std::move(elements[i]));
+        elements[i].~Element();
+      }
+
+      if (!isInline())
+        poeArenaFree(NULL, elements);
+    }
+
+    elements = newElements;
+    capacity = newCapacity;
+
+    return POE_TRUE;
+  } // relocate end
+}; // struct PoeArray end
+
+#endif // !defined(POE_ARRAY_H_)
+
+// poe_array.h file end
@@ -0,0 +1,249 @@
+/**
+ * @file   poe/poe_compact.cpp
+ * @author tiot2
+ * @brief  Poem processor compact text implementation module
+ */
+
+#include "poe.h"
+
+/**
+ * @brief text strings in initial (parsing) order getting function
+ *
+ * @param text    text
+ * @param strings text strings in initial order (output)
+ * @param owned   strings allocated by function (output, NULL if text strings are in initial order already)
+ *
+ * @note parsed strings are laid out in memory in initial order, so initial order is address order
+ *
+ * @return operation status
+ */
+static PoeStatus
+poeCompactGetInitialOrder( const PoeText *const text, const PoeString **const strings, PoeString **const owned ) {
+  PoeBool isInitial = POE_TRUE;
+
+  for (size_t i = 1; isInitial && i < text->stringCount; i++)
+    isInitial = text->strings[i - 1].begin < text->strings[i].begin;
+
+  *owned = NULL;
+  *strings = text->strings;
+
+  if (isInitial)
+    return POE_STATUS_OK;
+
+  PoeString *copy = (PoeString *)poeArenaAllocate(NULL, text->stringCount * sizeof(PoeString));
+
+  if (copy == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  memcpy(copy, text->strings, text->stringCount * sizeof(PoeString));
+
+  PoeText copyText = {0};
+  copyText.strings = copy;
+  copyText.stringCount = text->stringCount;
+  poeSortTextT<PoeCompareInitialOrderFunctor>(&copyText);
+
+  *owned = copy;
+  *strings = copy;
+
+  return POE_STATUS_OK;
+} // poeCompactGetInitialOrder function end
+
+PoeStatus POE_API
+poeCreateCompactText( const PoeText *const text, PoeCompactText *const dst, PoeArena *const arena ) {
+  assert(text != NULL);
+  assert(dst != NULL);
+
+  memset(dst, 0, sizeof(PoeCompactText));
+
+  if (text->stringCount >= UINT32_MAX)
+    return POE_STATUS_BAD_FORMAT;
+
+  const PoeString *strings;
+  PoeString *ownedStrings;
+  PoeStatus status;
+
+  if (!POE_CHECK(status = poeCompactGetInitialOrder(text, &strings, &ownedStrings)))
+    return status;
+
+  uint32_t *offsets = (uint32_t *)poeArenaAllocate(arena, (text->stringCount + 1) * sizeof(uint32_t));
+
+  if (offsets == NULL) {
+    free(ownedStrings);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  const char *const data = text->stringCount == 0 ? NULL : strings[0].begin;
+  PoeBool ok = POE_TRUE;
+
+  for (size_t i = 0; ok && i < text->stringCount; i++)
+    if ((ok = (size_t)(strings[i].begin - data) < UINT32_MAX))
+      offsets[i] = (uint32_t)(strings[i].begin - data);
+
+  // uniform separator size lets string ends be derived without data access
+  const size_t firstSeparatorSize = text->stringCount < 2 ? 1 : (size_t)(strings[1].begin - strings[0].end);
+  uint32_t separatorSize = firstSeparatorSize < UINT32_MAX ? (uint32_t)firstSeparatorSize : 0;
+
+  for (size_t i = 2; ok && separatorSize != 0 && i < text->stringCount; i++)
+    if ((size_t)(strings[i].begin - strings[i - 1].end) != separatorSize)
+      separatorSize = 0;
+
+  if (text->stringCount == 0)
+    offsets[0] = 0;
+  else if (ok) {
+    const char *const end = strings[text->stringCount - 1].end + (separatorSize == 0 ? 1 : separatorSize);
+
+    if ((ok = (size_t)(end - data) <= UINT32_MAX))
+      offsets[text->stringCount] = (uint32_t)(end - data);
+  }
+
+  dst->data = data;
+  dst->offsets = offsets;
+  dst->offsetCapacity = text->stringCount + 1;
+  dst->stringCount = text->stringCount;
+  dst->separatorSize = separatorSize;
+  dst->arena = arena;
+
+  // every derived string must match text one
+  for (size_t i = 0; ok && i < text->stringCount; i++) {
+    const PoeString string = poeCompactGetString(dst, (uint32_t)i);
+
+    ok = string.begin == strings[i].begin && string.end == strings[i].end;
+  }
+
+  free(ownedStrings);
+
+  if (!ok) {
+    poeDestroyCompactText(dst);
+    return POE_STATUS_BAD_FORMAT;
+  }
+
+  return POE_STATUS_OK;
+} // poeCreateCompactText function end
+
+PoeStatus POE_API
+poeAppendCompactText( PoeCompactText *const compact, const PoeText *const text, const PoeTextAppend *const append ) {
+  assert(compact != NULL);
+  assert(text != NULL);
+  assert(append != NULL);
+  assert(compact->stringCount == append->firstStringIndex);
+
+  const size_t oldCount = compact->stringCount;
+  const size_t newCount = text->stringCount;
+  const PoeString *const strings = text->strings;
+
+  if (newCount == oldCount)
+    return POE_STATUS_OK;
+
+  if (newCount >= UINT32_MAX)
+    return POE_STATUS_BAD_FORMAT;
+
+  // geometric growth, so old offsets are not copied by every append
+  if (newCount + 1 > compact->offsetCapacity) {
+    size_t capacity = compact->offsetCapacity * 2;
+
+    if (capacity < newCount + 1)
+      capacity = newCount + 1;
+
+    uint32_t *const offsets = (uint32_t *)poeArenaReallocate(
+      compact->arena,
+      compact->offsets,
+      compact->offsetCapacity * sizeof(uint32_t),
+      capacity * sizeof(uint32_t)
+    );
+
+    if (offsets == NULL)
+      return POE_STATUS_BAD_ALLOC;
+
+    compact->offsets = offsets;
+    compact->offsetCapacity = capacity;
+  }
+
+  uint32_t *const offsets = compact->offsets;
+
+  // last old string end must stay the same after its past-the-end offset is replaced by appended string begin
+  PoeString oldLast = {0};
+
+  if (oldCount == 0)
+    compact->data = strings[oldCount].begin;
+  else {
+    compact->data += append->dataShift;
+    oldLast = poeCompactGetString(compact, (uint32_t)(oldCount - 1));
+  }
+
+  const char *const data = compact->data;
+  PoeBool ok = POE_TRUE;
+
+  for (size_t i = oldCount; ok && i < newCount; i++)
+    if ((ok = strings[i].begin >= data && (size_t)(strings[i].begin - data) < UINT32_MAX))
+      offsets[i] = (uint32_t)(strings[i].begin - data);
+
+  // appended strings are separated by single '\0', as are ones of string buffer; old strings never
+  // contain trailing '\r' characters, so '\r' trimming gives same ends if separators differ
+  for (size_t i = oldCount == 0 ? 1 : oldCount; ok && compact->separatorSize != 0 && i < newCount; i++) {
+    const char *const previousEnd = i == oldCount ? oldLast.end : strings[i - 1].end;
+
+    if ((size_t)(strings[i].begin - previousEnd) != compact->separatorSize)
+      compact->separatorSize = 0;
+  }
+
+  if (ok) {
+    const char *const end = strings[newCount - 1].end + (compact->separatorSize == 0 ? 1 : compact->separatorSize);
+
+    if ((ok = (size_t)(end - data) <= UINT32_MAX))
+      offsets[newCount] = (uint32_t)(end - data);
+  }
+
+  compact->stringCount = newCount;
+
+  if (ok && oldCount != 0) {
+    const PoeString string = poeCompactGetString(compact, (uint32_t)(oldCount - 1));
+
+    ok = string.begin == oldLast.begin && string.end == oldLast.end;
+  }
+
+  for (size_t i = oldCount; ok && i < newCount; i++) {
+    const PoeString string = poeCompactGetString(compact, (uint32_t)i);
+
+    ok = string.begin == strings[i].begin && string.end == strings[i].end;
+  }
+
+  return ok ? POE_STATUS_OK : POE_STATUS_BAD_FORMAT;
+} // poeAppendCompactText function end
+
+PoeBool POE_API
+poeCompactFindString( const PoeCompactText *const text, const char *const begin, uint32_t *const dst ) {
+  assert(text != NULL);
+  assert(dst != NULL);
+
+  if (text->stringCount == 0 || begin < text->data)
+    return POE_FALSE;
+
+  const size_t offset = begin - text->data;
+  size_t left = 0;
+  size_t right = text->stringCount;
+
+  while (left < right) {
+    const size_t middle = left + (right - left) / 2;
+
+    if (text->offsets[middle] < offset)
+      left = middle + 1;
+    else
+      right = middle;
+  }
+
+  if (left == text->stringCount || text->offsets[left] != offset)
+    return POE_FALSE;
+
+  *dst = (uint32_t)left;
+  return POE_TRUE;
+} // poeCompactFindString function end
+
+void POE_API
+poeDestroyCompactText( PoeCompactText *const text ) {
+  assert(text != NULL);
+
+  poeArenaFree(text->arena, text->offsets);
+  memset(text, 0, sizeof(PoeCompactText));
+} // poeDestroyCompactText function end
+
+// poe_compact.cpp file end
@@ -0,0 +1,109 @@
+/**
+ * @file   poe/poe_compact.h
+ * @author tiot2
+ * @brief  Poem processor compact text declaration module
+ *
+ * Compact text stores every string as 32-bit offset of its begin in text data. String end is not
+ * stored but derived from begin of next string, as parsed strings are laid out one after another
+ * and separated by single '\0' (string buffer) or by '\n' with trailing '\r' characters (file mapping).
+ * So compact text takes 4 bytes per string instead of 16 ones of PoeString.
+ */
+
+#ifndef POE_COMPACT_H_
+#define POE_COMPACT_H_
+
+#include "poe_core.h"
+
+/// compact text representation structure
+typedef struct __PoeCompactText {
+  const char * data;           ///< data string offsets are counted from
+  uint32_t   * offsets;        ///< string begin offsets in initial order (stringCount + 1 elements, last one is past-the-end offset of last string plus separator size)
+  size_t       offsetCapacity; ///< count of allocated offsets
+  size_t       stringCount;    ///< count of strings
+  uint32_t     separatorSize;  ///< size of separator every string is followed by (0 if sizes differ, so ends are found by '\r' trimming)
+  PoeArena   * arena;          ///< arena offsets are allocated from (NULL if they are heap ones)
+} PoeCompactText;
+
+/**
+ * @brief compact text creation function
+ *
+ * @param text  text to create compact text of (strings may be in any order)
+ * @param dst   compact text (must be destroyed by poeDestroyCompactText)
+ * @param arena arena to allocate compact text from (NULL for heap)
+ *
+ * @note compact text keeps strings in initial (parsing) order, so it stays valid after text sorting
+ *
+ * @return operation status (POE_STATUS_BAD_FORMAT if text data is longer than UINT32_MAX bytes
+ *         or text strings are not laid out as parsing lays them out)
+ */
+PoeStatus POE_API
+poeCreateCompactText( const PoeText *text, PoeCompactText *dst, PoeArena *arena );
+
+/**
+ * @brief compact text by appended text strings extending function
+ *
+ * @param compact compact text of text strings before append
+ * @param text    text strings were appended to by poeAppendText (appended strings must not be reordered yet)
+ * @param append  append result
+ *
+ * @note old strings keep their indices and offsets grow geometrically, so cost is proportional
+ *       to count of appended strings on average (compact text must be destroyed if failed)
+ *
+ * @return operation status (POE_STATUS_BAD_FORMAT if text data gets longer than UINT32_MAX bytes)
+ */
+PoeStatus POE_API
+poeAppendCompactText( PoeCompactText *compact, const PoeText *text, const PoeTextAppend *append );
+
+/**
+ * @brief compact text string getting function
+ *
+ * @param text  compact text
+ * @param index string index in initial order
+ *
+ * @return string
+ */
+inline PoeString
+poeCompactGetString( const PoeCompactText *const text, const uint32_t index ) {
+  assert(text != NULL);
+  assert(index < text->stringCount);
+
+  PoeString string;
+
+  string.begin = (char *)text->data + text->offsets[index];
+
+  if (text->separatorSize != 0) {
+    string.end = (char *)text->data + text->offsets[index + 1] - text->separatorSize;
+    return string;
+  }
+
+  // mapped strings are separated by '\n' with varying count of trailing '\r' characters
+  string.end = (char *)text->data + text->offsets[index + 1] - 1;
+  while (string.end > string.begin && string.end[-1] == '\r')
+    string.end--;
+
+  return string;
+} // poeCompactGetString function end
+
+/**
+ * @brief compact text string index by string begin finding function
+ *
+ * @param text  compact text
+ * @param begin begin of string to find
+ * @param dst   string index in initial order (output)
+ *
+ * @return POE_TRUE if found, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeCompactFindString( const PoeCompactText *text, const char *begin, uint32_t *dst );
+
+/**
+ * @brief compact text destroy function
+ *
+ * @param text text to destroy (zero-initialized texts may be destroyed too)
+ */
+void POE_API
+poeDestroyCompactText( PoeCompactText *text );
+
+#endif // !defined(POE_COMPACT_H_)
+
+// poe_compact.h file end
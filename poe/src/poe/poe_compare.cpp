@@ -6,153 +6,168 @@
 
 #include "poe.h"
 
-PoeOrdering POE_API
-poeCompareInitialOrder( const PoeString *lhs, const PoeString *rhs ) {
-  return poeCompareSize((size_t)lhs->begin, (size_t)rhs->begin);
-} // poeCompareInitialOrder function end
-
 /**
- * @brief cyrillic character test
+ * @brief ASCII part of collation table filling function
  * 
- * @param c character to test
+ * @param table table to fill
  * 
- * @return POE_TRUE if cyrillic in 1251, POE_FALSE otherwise
+ * @note matches "C" locale isdigit/isalpha/isspace/tolower behaviour
  */
-static inline PoeBool
-poeIsCyrillicAlpha( unsigned char c ) {
-  return c >= 0xC0 && c <= 0xFF || c == 0xA8 || c == 0xB8;
-} // poeIsCyrillicAlpha function end
-
-PoeBool POE_API
-poeCompareCheckCharacterComparability( unsigned char c ) {
-  return poeIsCyrillicAlpha(c) || isdigit(c) || isalpha(c) || isspace(c);
-} // poeCompareCheckCharacterComparability function end
-
-unsigned char POE_API
-poeCompareProcessCharacter( unsigned char c ) {
-  // ASCII
-  if (c <= 0x7F)
-    return (unsigned char)tolower(c);
-
-  // jo
-  if (c == 0xA8 || c == 0xB8)
-    return 0x86;
-
-  // uppercase
-  if (c <= 0xC5) return c - 0x40;
-  if (c <= 0xDf) return c - 0x3F;
-
-  // lowercase
-  if (c <= 0xE5) return c - 0x60;
-  if (c <= 0xFF) return c - 0x5F;
-
-  // ERROR
-  assert(POE_FALSE);
-  return 0xFF;
-} // poeCompareProcessCharacter function end
+static constexpr void
+poeCollationFillAscii( PoeCollationTable &table ) {
+  for (unsigned int c = '0'; c <= '9'; c++)
+    table.weights[c] = (unsigned char)c;
+
+  for (unsigned int c = 'a'; c <= 'z'; c++)
+    table.weights[c] = table.weights[c - 'a' + 'A'] = (unsigned char)c;
+
+  constexpr unsigned char spaces[] = {' ', '\t', '\n', '\v', '\f', '\r'};
+
+  for (const unsigned char c : spaces)
+    table.weights[c] = c;
+} // poeCollationFillAscii function end
 
 /**
- * @brief helper function
+ * @brief cyrillic letter weight getting function
  * 
- * @param hs pointer to current character
+ * @param alphabetIndex index of letter in russian alphabet (0 for 'a', 6 for 'jo', 32 for 'ja')
  * 
- * @return helper structure
+ * @return letter weight (cyrillic letters follow all ASCII characters)
  */
-static struct __PoeResultOf_poeCompareFromStartHelper {
-  const char *  ptr; /// pointer
-  unsigned char c;   /// character
-}
-poeCompareFromStartHelper( const char *const hs ) {
-  struct __PoeResultOf_poeCompareFromStartHelper res = {
-    .ptr = hs,
-    .c = (unsigned char)*hs,
-  };
+static constexpr unsigned char
+poeCollationCyrillicWeight( const unsigned int alphabetIndex ) {
+  return (unsigned char)(0x80 + alphabetIndex);
+} // poeCollationCyrillicWeight function end
 
-  while (res.c != '\0' && !poeCompareCheckCharacterComparability(res.c))
-    res.c = *++res.ptr;
-  res.c = poeCompareProcessCharacter(res.c);
+/**
+ * @brief Windows-1251 collation table building function
+ * 
+ * @return collation table
+ */
+static constexpr PoeCollationTable
+poeCollationBuildCp1251( void ) {
+  PoeCollationTable table = {};
 
-  return res;
-} // poeCompareFromStartHelper function end
+  poeCollationFillAscii(table);
 
-PoeOrdering POE_API
-poeCompareFromStart( const PoeString *const lhs, const PoeString *const rhs ) {
-  assert(lhs != NULL);
-  assert(rhs != NULL);
+  // uppercase letters are 0xC0..0xDF, lowercase ones are 0xE0..0xFF, 'jo' is placed separately
+  for (unsigned int c = 0xC0; c <= 0xFF; c++) {
+    const unsigned int letter = c & 0x1F;
+
+    table.weights[c] = poeCollationCyrillicWeight(letter < 6 ? letter : letter + 1);
+  }
+
+  table.weights[0xA8] = table.weights[0xB8] = poeCollationCyrillicWeight(6);
 
-  struct __PoeResultOf_poeCompareFromStartHelper
-    left  = { .ptr = lhs->begin },
-    right = { .ptr = rhs->begin };
+  return table;
+} // poeCollationBuildCp1251 function end
 
-  while (POE_TRUE) {
-    // function
+/**
+ * @brief KOI8-R collation table building function
+ * 
+ * @return collation table
+ */
+static constexpr PoeCollationTable
+poeCollationBuildKoi8r( void ) {
+  // alphabet indices of KOI8-R letters 0xC0..0xDF (lowercase) and 0xE0..0xFF (uppercase)
+  constexpr unsigned char alphabetIndices[32] = {
+    31,  0,  1, 23,  4,  5, 21,  3, 22,  9, 10, 11, 12, 13, 14, 15,
+    16, 32, 17, 18, 19, 20,  7,  2, 29, 28,  8, 25, 30, 26, 24, 27,
+  };
+  PoeCollationTable table = {};
 
-    left  = poeCompareFromStartHelper(left.ptr);
-    right = poeCompareFromStartHelper(right.ptr);
+  poeCollationFillAscii(table);
 
-    if (left.c == '\0' || right.c == '\0' || left.c != right.c)
-      break;
+  for (unsigned int i = 0; i < 32; i++)
+    table.weights[0xC0 + i] = table.weights[0xE0 + i] = poeCollationCyrillicWeight(alphabetIndices[i]);
 
-    left.ptr++;
-    right.ptr++;
-  }
+  table.weights[0xA3] = table.weights[0xB3] = poeCollationCyrillicWeight(6);
 
-  return poeCompareSize(
-    (unsigned char)poeCompareProcessCharacter(*left.ptr),
-    (unsigned char)poeCompareProcessCharacter(*right.ptr)
-  );
-} // poeCompareFromStart function end
+  return table;
+} // poeCollationBuildKoi8r function end
 
 /**
- * @brief helper function
- * 
- * @param hs pointer to current character
+ * @brief ISO-8859-1 collation table building function
  * 
- * @return helper structure
+ * @return collation table
  */
-static struct __PoeResultOf_poeCompareFromEndHelper {
-  const char *  ptr; /// pointer
-  unsigned char c;   /// character
-}
-poeCompareFromEndHelper( const char *const hs ) {
-  struct __PoeResultOf_poeCompareFromEndHelper res = {
-    .ptr = hs,
-    .c = (unsigned char)*hs,
-  };
+static constexpr PoeCollationTable
+poeCollationBuildLatin1( void ) {
+  PoeCollationTable table = {};
 
-  while (res.c != '\0' && !poeCompareCheckCharacterComparability(res.c))
-    res.c = *--res.ptr;
-  res.c = poeCompareProcessCharacter(res.c);
+  poeCollationFillAscii(table);
 
-  return res;
-} // poeCompareFromEndHelper function end
+  // uppercase letters 0xC0..0xDE are folded to lowercase ones 0xE0..0xFE, 0xD7 and 0xF7 are signs
+  for (unsigned int c = 0xC0; c <= 0xFF; c++)
+    if (c != 0xD7 && c != 0xF7)
+      table.weights[c] = (unsigned char)(c < 0xDF ? c + 0x20 : c);
 
-PoeOrdering POE_API
-poeCompareFromEnd( const PoeString *const lhs, const PoeString *const rhs ) {
-  assert(lhs != NULL);
-  assert(rhs != NULL);
+  return table;
+} // poeCollationBuildLatin1 function end
+
+/// Windows-1251 collation table
+static constexpr PoeCollationTable poeCollationCp1251 = poeCollationBuildCp1251();
 
-  struct __PoeResultOf_poeCompareFromEndHelper
-    left  = { .ptr = lhs->end - 1, },
-    right = { .ptr = rhs->end - 1, };
+/// KOI8-R collation table
+static constexpr PoeCollationTable poeCollationKoi8r = poeCollationBuildKoi8r();
 
-  while (POE_TRUE) {
-    // function
+/// ISO-8859-1 collation table
+static constexpr PoeCollationTable poeCollationLatin1 = poeCollationBuildLatin1();
 
-    left  = poeCompareFromEndHelper(left.ptr);
-    right = poeCompareFromEndHelper(right.ptr);
+static_assert(poeCollationCp1251.weights['A'] == 'a' && poeCollationCp1251.weights['.'] == 0, "ASCII collation");
+static_assert(poeCollationCp1251.weights[0xC0] == 0x80 && poeCollationCp1251.weights[0xE6] == 0x87 && poeCollationCp1251.weights[0xFF] == 0xA0, "cp1251 collation");
+static_assert(poeCollationKoi8r.weights[0xC1] == poeCollationCp1251.weights[0xE0] && poeCollationKoi8r.weights[0xF1] == poeCollationCp1251.weights[0xDF], "KOI8-R collation");
 
-    if (left.c == '\0' || right.c == '\0' || left.c != right.c)
-      break;
+const PoeCollationTable *poeCompareCurrentCollation = &poeCollationCp1251;
 
-    left.ptr--;
-    right.ptr--;
+void POE_API
+poeCompareSetEncoding( const PoeEncoding encoding ) {
+  switch (encoding) {
+  case POE_ENCODING_CP1251 : poeCompareCurrentCollation = &poeCollationCp1251; break;
+  case POE_ENCODING_KOI8R  : poeCompareCurrentCollation = &poeCollationKoi8r ; break;
+  case POE_ENCODING_LATIN1 : poeCompareCurrentCollation = &poeCollationLatin1; break;
   }
+} // poeCompareSetEncoding function end
+
+PoeEncoding POE_API
+poeCompareGetEncoding( void ) {
+  if (poeCompareCurrentCollation == &poeCollationKoi8r)
+    return POE_ENCODING_KOI8R;
+  if (poeCompareCurrentCollation == &poeCollationLatin1)
+    return POE_ENCODING_LATIN1;
+  return POE_ENCODING_CP1251;
+} // poeCompareGetEncoding function end
+
+const char * POE_API
+poeCompareGetEncodingName( const PoeEncoding encoding ) {
+  switch (encoding) {
+  case POE_ENCODING_CP1251 : return "cp1251";
+  case POE_ENCODING_KOI8R  : return "koi8r";
+  case POE_ENCODING_LATIN1 : return "latin1";
+  }
+
+  return "unknown";
+} // poeCompareGetEncodingName function end
+
+PoeOrdering POE_API
+poeCompareInitialOrder( const PoeString *const lhs, const PoeString *const rhs ) {
+  return PoeCompareInitialOrderFunctor()(lhs, rhs);
+} // poeCompareInitialOrder function end
+
+PoeOrdering POE_API
+poeCompareFromStart( const PoeString *const lhs, const PoeString *const rhs ) {
+  assert(lhs != NULL);
+  assert(rhs != NULL);
+
+  return PoeCompareFromStartFunctor()(lhs, rhs);
+} // poeCompareFromStart function end
+
+PoeOrdering POE_API
+poeCompareFromEnd( const PoeString *const lhs, const PoeString *const rhs ) {
+  assert(lhs != NULL);
+  assert(rhs != NULL);
 
-  return poeCompareSize(
-    (unsigned char)poeCompareProcessCharacter(*left.ptr),
-    (unsigned char)poeCompareProcessCharacter(*right.ptr)
-  );
+  return PoeCompareFromEndFunctor()(lhs, rhs);
 } // poeCompareFromEnd function end
 
 // poe_compare.cpp file end
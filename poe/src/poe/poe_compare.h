@@ -8,6 +8,7 @@
 #define POE_COMPARE_H_
 
 #include "poe_core.h"
+#include "poe_stats.h"
 
 /// Ordering
 typedef enum __PoeOrdering {
@@ -42,6 +43,52 @@ poeCompareSize( const size_t lhs, const size_t rhs ) {
  * character utilities (group PoeCharacterUtilFunctions)
  ***/
 
+/// single byte text encoding enumeration
+typedef enum __PoeEncoding {
+  POE_ENCODING_CP1251, ///< Windows-1251 (default)
+  POE_ENCODING_KOI8R,  ///< KOI8-R
+  POE_ENCODING_LATIN1, ///< ISO-8859-1
+} PoeEncoding;
+
+/// character collation table representation structure
+typedef struct __PoeCollationTable {
+  unsigned char weights[256]; ///< folded (case-insensitive, alphabetically ordered) character code, 0 if character is skipped by comparison
+} PoeCollationTable;
+
+/// current encoding collation table (changed by poeCompareSetEncoding only)
+extern const PoeCollationTable *poeCompareCurrentCollation;
+
+/**
+ * @brief text encoding setting function
+ * @ingroup PoeCharacterUtilFunctions
+ * 
+ * @param encoding encoding to compare strings in
+ * 
+ * @note must not be called while strings are compared or generators are built
+ */
+void POE_API
+poeCompareSetEncoding( PoeEncoding encoding );
+
+/**
+ * @brief current text encoding getting function
+ * @ingroup PoeCharacterUtilFunctions
+ * 
+ * @return encoding
+ */
+PoeEncoding POE_API
+poeCompareGetEncoding( void );
+
+/**
+ * @brief encoding name getting function
+ * @ingroup PoeCharacterUtilFunctions
+ * 
+ * @param encoding encoding to get name of
+ * 
+ * @return encoding name
+ */
+const char * POE_API
+poeCompareGetEncodingName( PoeEncoding encoding );
+
 /**
  * @brief check if character can be used
  * @ingroup PoeCharacterUtilFunctions
@@ -50,8 +97,10 @@ poeCompareSize( const size_t lhs, const size_t rhs ) {
  * 
  * @return POE_TRUE if ok, POE_FALSE if should be skipped
  */
-PoeBool POE_API
-poeCompareCheckCharacterComparability( unsigned char c );
+inline PoeBool POE_API
+poeCompareCheckCharacterComparability( const unsigned char c ) {
+  return poeCompareCurrentCollation->weights[c] != 0;
+} // poeCompareCheckCharacterComparability function end
 
 /**
  * @brief character re-encoding function
@@ -59,12 +108,14 @@ poeCompareCheckCharacterComparability( unsigned char c );
  * 
  * @param c character
  * 
- * @note accepts ASCII or passed by poeCompareCheckCharacterComparability function characters only
+ * @note accepts passed by poeCompareCheckCharacterComparability function characters only
  * 
  * @return re-encoded character
  */
-unsigned char POE_API
-poeCompareProcessCharacter( unsigned char c );
+inline unsigned char POE_API
+poeCompareProcessCharacter( const unsigned char c ) {
+  return poeCompareCurrentCollation->weights[c];
+} // poeCompareProcessCharacter function end
 
 /**
  * @brief string compare function pointer definition
@@ -119,6 +170,132 @@ poeCompareFromStart( const PoeString *lhs, const PoeString *rhs );
 PoeOrdering POE_API
 poeCompareFromEnd( const PoeString *lhs, const PoeString *rhs );
 
+/***
+ * compare functors (group PoeStringCompareFunctors)
+ *
+ * functors are inlined into poeSortTextT instantiations, while
+ * compare functions above are implemented by them
+ ***/
+
+/// by initial parsing order compare functor
+struct PoeCompareInitialOrderFunctor {
+  /**
+   * @brief compare operator
+   * 
+   * @param lhs left hand side
+   * @param rhs right hand side
+   * 
+   * @return ordering
+   */
+  inline PoeOrdering
+  operator()( const PoeString *const lhs, const PoeString *const rhs ) const {
+    POE_STATS_COMPARISON(0);
+    return poeCompareSize((size_t)lhs->begin, (size_t)rhs->begin);
+  } // operator() end
+}; // struct PoeCompareInitialOrderFunctor end
+
+/// from begin to end compare functor
+struct PoeCompareFromStartFunctor {
+  /**
+   * @brief compare operator
+   * 
+   * @param lhs left hand side
+   * @param rhs right hand side
+   * 
+   * @return ordering
+   */
+  inline PoeOrdering
+  operator()( const PoeString *const lhs, const PoeString *const rhs ) const {
+    const unsigned char *const weights = poeCompareCurrentCollation->weights;
+    const char *left = lhs->begin;
+    const char *right = rhs->begin;
+    unsigned char leftCharacter = '\0';
+    unsigned char rightCharacter = '\0';
+
+    while (POE_TRUE) {
+      // weight is '\0' for skipped characters and if string end reached
+      while (left < lhs->end && (leftCharacter = weights[(unsigned char)*left]) == '\0')
+        left++;
+      if (left == lhs->end)
+        leftCharacter = '\0';
+
+      while (right < rhs->end && (rightCharacter = weights[(unsigned char)*right]) == '\0')
+        right++;
+      if (right == rhs->end)
+        rightCharacter = '\0';
+
+      if (leftCharacter == '\0' || rightCharacter == '\0' || leftCharacter != rightCharacter) {
+        POE_STATS_COMPARISON((left - lhs->begin) + (right - rhs->begin));
+        return poeCompareSize(leftCharacter, rightCharacter);
+      }
+
+      left++;
+      right++;
+    }
+  } // operator() end
+}; // struct PoeCompareFromStartFunctor end
+
+/// from end to begin compare functor
+struct PoeCompareFromEndFunctor {
+  /**
+   * @brief compare operator
+   * 
+   * @param lhs left hand side
+   * @param rhs right hand side
+   * 
+   * @return ordering
+   */
+  inline PoeOrdering
+  operator()( const PoeString *const lhs, const PoeString *const rhs ) const {
+    const unsigned char *const weights = poeCompareCurrentCollation->weights;
+
+    // pointers to characters after current ones
+    const char *left = lhs->end;
+    const char *right = rhs->end;
+    unsigned char leftCharacter = '\0';
+    unsigned char rightCharacter = '\0';
+
+    while (POE_TRUE) {
+      // weight is '\0' for skipped characters and if string begin reached
+      while (left > lhs->begin && (leftCharacter = weights[(unsigned char)left[-1]]) == '\0')
+        left--;
+      if (left == lhs->begin)
+        leftCharacter = '\0';
+
+      while (right > rhs->begin && (rightCharacter = weights[(unsigned char)right[-1]]) == '\0')
+        right--;
+      if (right == rhs->begin)
+        rightCharacter = '\0';
+
+      if (leftCharacter == '\0' || rightCharacter == '\0' || leftCharacter != rightCharacter) {
+        POE_STATS_COMPARISON((lhs->end - left) + (rhs->end - right));
+        return poeCompareSize(leftCharacter, rightCharacter);
+      }
+
+      left--;
+      right--;
+    }
+  } // operator() end
+}; // struct PoeCompareFromEndFunctor end
+
+/// compare function pointer calling functor
+struct PoeCompareFnFunctor {
+  PoeStringCompareFn compareFn; ///< compare function
+
+  /**
+   * @brief compare operator
+   * 
+   * @param lhs left hand side
+   * @param rhs right hand side
+   * 
+   * @return ordering
+   */
+  inline PoeOrdering
+  operator()( const PoeString *const lhs, const PoeString *const rhs ) const {
+    return compareFn(lhs, rhs);
+  } // operator() end
+}; // struct PoeCompareFnFunctor end
+
 #endif // !defined(POE_COPMARE_H_)
 
 // poe_compare.h file end
@@ -6,77 +6,524 @@
  */
 
 #include "poe.h"
+#include "poe_scan.h"
+#include "poe_parallel.h"
 
-PoeStatus POE_API
-poeParseText( FILE *const file, PoeText *const dst ) {
-  assert(file != NULL);
-  assert(dst != NULL);
+/**
+ * @brief text from raw data building function
+ * 
+ * @param stringBuffer buffer to build text strings in (zeroed, at least size + 2 bytes)
+ * @param source       text data (may be stringBuffer + 1)
+ * @param size         text data size
+ * @param dst          built text
+ * @param arena        arena stringBuffer is allocated from and strings are to be allocated from (NULL for heap)
+ * 
+ * @note takes ownership on stringBuffer (frees it in case of failure)
+ * 
+ * @return operation status
+ */
+static PoeStatus
+poeBuildText( char *const stringBuffer, const char *const source, const size_t size, PoeText *const dst, PoeArena *const arena ) {
+  PoeScanResult scan = {0};
+  PoeStatus status = poeScanLines(stringBuffer + 1, source, size, &scan, arena);
+
+  if (!POE_CHECK(status)) {
+    poeArenaFree(arena, stringBuffer);
+    return status;
+  }
+
+  // with starting and ending \0
+  memset(stringBuffer + 1 + scan.size, 0, size + 1 - scan.size);
+
+  memset(dst, 0, sizeof(PoeText));
+  dst->stringBuffer = stringBuffer;
+  dst->stringCount = scan.stringCount;
+  dst->strings = scan.strings;
+  dst->stringCapacity = scan.stringCount;
+  dst->stringBufferSize = scan.size + 2;
+  dst->stringBufferCapacity = size + 2;
+  dst->arena = arena;
 
+  return POE_STATUS_OK;
+} // poeBuildText function end
+
+/**
+ * @brief whole file reading function
+ * 
+ * @param file  file to read
+ * @param size  read data size (output)
+ * @param arena arena to allocate buffer from (NULL for heap)
+ * 
+ * @return buffer with file data starting at 1st byte and followed by '\0' (NULL if allocation failed)
+ */
+static char *
+poeReadFile( FILE *const file, size_t *const size, PoeArena *const arena ) {
   fseek(file, 0, SEEK_END);
-  size_t size = ftell(file);
+  *size = ftell(file);
   fseek(file, 0, SEEK_SET);
 
   // with starting and ending \0
-  char *stringBuffer = (char *)calloc(size + 2, 1);
+  char *stringBuffer = (char *)poeArenaAllocateZeroed(arena, *size + 2, 1);
+  if (stringBuffer == NULL)
+    return NULL;
+  fread(stringBuffer + 1, 1, *size, file);
+
+  return stringBuffer;
+} // poeReadFile function end
+
+PoeStatus POE_API
+poeParseText( FILE *const file, PoeText *const dst, PoeArena *const arena ) {
+  assert(file != NULL);
+  assert(dst != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_PARSE);
+
+  size_t size = 0;
+  char *stringBuffer = poeReadFile(file, &size, arena);
+
+  if (stringBuffer == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  return poeBuildText(stringBuffer, stringBuffer + 1, size, dst, arena);
+} // poeParseText function end
+
+/// parallel parsing text chunk representation structure
+typedef struct __PoeParseChunk {
+  char   * begin;       ///< chunk data begin
+  char   * end;         ///< chunk data end (before '\r' removal)
+  size_t   size;        ///< chunk data size after '\r' removal
+  size_t   stringIndex; ///< index of first string that begins in chunk
+  size_t   lineCount;   ///< count of '\n' characters in chunk
+} PoeParseChunk;
+
+/// parallel parsing context representation structure
+typedef struct __PoeParseContext {
+  PoeParseChunk * chunks;      ///< chunk array
+  size_t          chunkCount;  ///< count of chunks
+  PoeString     * strings;     ///< text strings
+  size_t          stringCount; ///< count of text strings
+} PoeParseContext;
+
+/**
+ * @brief chunk '\r' removal and line counting function
+ * 
+ * @param context   parsing context
+ * @param taskIndex index of chunk to process
+ */
+static void POE_API
+poeParseChunkCount( void *const context, const size_t taskIndex ) {
+  PoeParseChunk *const chunk = ((PoeParseContext *)context)->chunks + taskIndex;
+  char *writer = chunk->begin;
+  size_t lineCount = 0;
+
+  if (memchr(chunk->begin, '\r', chunk->end - chunk->begin) == NULL) {
+    writer = chunk->end;
+
+    for (const char *iter = chunk->begin; iter < chunk->end; iter++)
+      lineCount += (*iter == '\n');
+  } else {
+    for (const char *iter = chunk->begin; iter < chunk->end; iter++) {
+      if (*iter == '\r')
+        continue;
+      lineCount += (*iter == '\n');
+      *writer++ = *iter;
+    }
+  }
+
+  chunk->size = writer - chunk->begin;
+  chunk->lineCount = lineCount;
+} // poeParseChunkCount function end
+
+/**
+ * @brief chunk strings filling function
+ * 
+ * @param context   parsing context
+ * @param taskIndex index of chunk to process
+ */
+static void POE_API
+poeParseChunkFill( void *const context, const size_t taskIndex ) {
+  PoeParseContext *const parse = (PoeParseContext *)context;
+  const PoeParseChunk *const chunk = parse->chunks + taskIndex;
+  PoeString *stringIter = parse->strings + chunk->stringIndex;
+  char *const chunkEnd = chunk->begin + chunk->size;
+  char *lineBegin = chunk->begin;
+
+  for (char *iter = chunk->begin; iter < chunkEnd; iter++) {
+    if (*iter != '\n')
+      continue;
+
+    *iter = '\0';
+    stringIter->begin = lineBegin;
+    stringIter->end = iter;
+    stringIter++;
+    lineBegin = iter + 1;
+  }
+
+  // every chunk except the last one ends by '\n'
+  if (taskIndex == parse->chunkCount - 1) {
+    stringIter->begin = lineBegin;
+    stringIter->end = chunkEnd;
+  }
+} // poeParseChunkFill function end
+
+PoeStatus POE_API
+poeParseTextParallel( FILE *const file, PoeText *const dst, size_t threadCount, PoeArena *const arena ) {
+  assert(file != NULL);
+  assert(dst != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_PARSE);
+
+  if (threadCount == 0)
+    threadCount = poeParallelGetHardwareThreadCount();
+
+  size_t size = 0;
+  char *stringBuffer = poeReadFile(file, &size, arena);
+
   if (stringBuffer == NULL)
     return POE_STATUS_BAD_ALLOC;
-  fread(stringBuffer + 1, 1, size, file);
 
-  char *writer = stringBuffer + 1;
-  const char *reader = stringBuffer + 1;
-  char *readerEnd = stringBuffer + size + 1;
+  // several chunks per thread to balance load
+  const size_t chunkCount = threadCount == 1 ? 1 : threadCount * 4;
+  PoeParseChunk *chunks = (PoeParseChunk *)poeArenaAllocateZeroed(NULL, chunkCount, sizeof(PoeParseChunk));
+
+  if (chunks == NULL) {
+    poeArenaFree(arena, stringBuffer);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  // split buffer into chunks aligned to lines
+  {
+    char *const data = stringBuffer + 1;
+    char *const dataEnd = data + size;
+    char *chunkBegin = data;
+
+    for (size_t i = 0; i < chunkCount; i++) {
+      char *chunkEnd = dataEnd;
+
+      if (i != chunkCount - 1) {
+        chunkEnd = data + size / chunkCount * (i + 1);
+
+        if (chunkEnd < chunkBegin)
+          chunkEnd = chunkBegin;
+
+        char *lineEnd = (char *)memchr(chunkEnd, '\n', dataEnd - chunkEnd);
+        chunkEnd = lineEnd == NULL ? dataEnd : lineEnd + 1;
+      }
+
+      chunks[i].begin = chunkBegin;
+      chunks[i].end = chunkEnd;
+      chunkBegin = chunkEnd;
+    }
+  }
+
+  PoeParseContext context = {
+    .chunks = chunks,
+    .chunkCount = chunkCount,
+    .strings = NULL,
+    .stringCount = 0,
+  };
+
+  poeParallelFor(chunkCount, threadCount, poeParseChunkCount, &context);
+
+  size_t stringBufferSize = 0;
 
-  while (reader < readerEnd) {
-    while (*reader == '\r')
-      reader++;
-    *writer++ = *reader++;
+  // join chunks after '\r' removal and find string indices
+  {
+    char *writer = stringBuffer + 1;
+    size_t stringIndex = 0;
+
+    for (size_t i = 0; i < chunkCount; i++) {
+      if (chunks[i].begin != writer) {
+        memmove(writer, chunks[i].begin, chunks[i].size);
+        chunks[i].begin = writer;
+      }
+      writer += chunks[i].size;
+
+      chunks[i].stringIndex = stringIndex;
+      stringIndex += chunks[i].lineCount;
+    }
+
+    memset(writer, 0, stringBuffer + size + 1 - writer);
+    context.stringCount = stringIndex + 1;
+    stringBufferSize = writer + 1 - stringBuffer;
   }
 
-  memset(writer, 0, readerEnd - writer);
+  if ((context.strings = (PoeString *)poeArenaAllocateZeroed(arena, context.stringCount, sizeof(PoeString))) == NULL) {
+    free(chunks);
+    poeArenaFree(arena, stringBuffer);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  poeParallelFor(chunkCount, threadCount, poeParseChunkFill, &context);
+
+  free(chunks);
 
+  memset(dst, 0, sizeof(PoeText));
+  dst->stringBuffer = stringBuffer;
+  dst->strings = context.strings;
+  dst->stringCount = context.stringCount;
+  dst->stringCapacity = context.stringCount;
+  dst->stringBufferSize = stringBufferSize;
+  dst->stringBufferCapacity = size + 2;
+  dst->arena = arena;
+
+  return POE_STATUS_OK;
+} // poeParseTextParallel function end
+
+PoeStatus POE_API
+poeParseTextMapped( const char *const fileName, PoeText *const dst, PoeArena *const arena ) {
+  assert(fileName != NULL);
+  assert(dst != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_PARSE);
+
+  PoeFileMapping mapping = {0};
+
+  if (!poeMapFile(fileName, &mapping))
+    return POE_STATUS_IO_ERROR;
+
+  // empty file has no mapping, so single empty string refers to static storage
+  static char emptyString[1] = {'\0'};
+  const char *const data = mapping.data != NULL ? mapping.data : emptyString;
+  const char *const dataEnd = data + mapping.size;
+
+  // count strings and check if every '\r' is trailing one of its line
   size_t stringCount = 1;
-  for (const char *t = stringBuffer; t < writer; t++)
-    stringCount += (*t == '\n');
-  PoeString *strings = (PoeString *)calloc(stringCount, sizeof(PoeString));
+  PoeBool needsCopy = POE_FALSE;
+
+  for (const char *iter = data; iter < dataEnd; iter++) {
+    if (*iter == '\n') {
+      stringCount++;
+    } else if (*iter == '\r') {
+      const char *crEnd = iter;
+
+      while (crEnd < dataEnd && *crEnd == '\r')
+        crEnd++;
+
+      if (crEnd < dataEnd && *crEnd != '\n') {
+        needsCopy = POE_TRUE;
+        break;
+      }
+      iter = crEnd - 1;
+    }
+  }
+
+  // fallback to copying parser
+  if (needsCopy) {
+    char *stringBuffer = (char *)poeArenaAllocateZeroed(arena, mapping.size + 2, 1);
+
+    if (stringBuffer == NULL) {
+      poeUnmapFile(&mapping);
+      return POE_STATUS_BAD_ALLOC;
+    }
+
+    PoeStatus status = poeBuildText(stringBuffer, mapping.data, mapping.size, dst, arena);
+    poeUnmapFile(&mapping);
+    return status;
+  }
+
+  PoeString *strings = (PoeString *)poeArenaAllocateZeroed(arena, stringCount, sizeof(PoeString));
 
   if (strings == NULL) {
-    free(stringBuffer);
+    poeUnmapFile(&mapping);
     return POE_STATUS_BAD_ALLOC;
   }
 
   {
     PoeString *stringIter = strings;
-    char *charIter = stringBuffer + 1;
-    char *const charIterEnd = writer;
-    
-    strings[0].begin = charIter;
-    strings[stringCount - 1].end = writer;
-
-    while (charIter < charIterEnd) {
-      if (*charIter == '\n') {
-        stringIter->end = charIter;
-        (stringIter + 1)->begin = charIter + 1;
-        *charIter = '\0';
-
-        stringIter++;
-      }
-      charIter++;
+    const char *lineBegin = data;
+
+    for (const char *iter = data; iter < dataEnd; iter++) {
+      if (*iter != '\n')
+        continue;
+
+      const char *lineEnd = iter;
+      while (lineEnd > lineBegin && lineEnd[-1] == '\r')
+        lineEnd--;
+
+      // mapping is read-only, strings are never written through
+      stringIter->begin = (char *)lineBegin;
+      stringIter->end = (char *)lineEnd;
+      stringIter++;
+
+      lineBegin = iter + 1;
     }
+
+    const char *lineEnd = dataEnd;
+    while (lineEnd > lineBegin && lineEnd[-1] == '\r')
+      lineEnd--;
+
+    stringIter->begin = (char *)lineBegin;
+    stringIter->end = (char *)lineEnd;
   }
 
-  dst->stringBuffer = stringBuffer;
-  dst->stringCount = stringCount;
+  memset(dst, 0, sizeof(PoeText));
   dst->strings = strings;
+  dst->stringCount = stringCount;
+  dst->stringCapacity = stringCount;
+  dst->mapping = mapping;
+  dst->arena = arena;
 
   return POE_STATUS_OK;
-} // poeParseText2 function end
+} // poeParseTextMapped function end
+
+/**
+ * @brief text strings shifting function
+ * 
+ * @param text  text to shift strings of
+ * @param shift shift
+ */
+static void
+poeShiftTextStrings( PoeText *const text, const ptrdiff_t shift ) {
+  for (size_t i = 0; i < text->stringCount; i++) {
+    text->strings[i].begin += shift;
+    text->strings[i].end += shift;
+  }
+} // poeShiftTextStrings function end
+
+/**
+ * @brief mapped text data to string buffer copying function
+ * 
+ * @param text     mapped text (unmapped by function if succeeded)
+ * @param capacity string buffer capacity (at least mapping size + 2)
+ * @param shift    shift of text strings (output)
+ * 
+ * @note data is copied as is, so strings keep their layout: last one is terminated by '\0'
+ *       written over its trailing '\r' characters or after data end
+ * 
+ * @return operation status
+ */
+static PoeStatus
+poeTextCopyMapping( PoeText *const text, const size_t capacity, ptrdiff_t *const shift ) {
+  assert(capacity >= text->mapping.size + 2);
+
+  // empty file has no mapping, so its single string refers to static storage
+  const char *const data = text->mapping.data != NULL ? text->mapping.data : text->strings[0].begin;
+
+  char *const stringBuffer = (char *)poeArenaAllocateZeroed(text->arena, capacity, 1);
+
+  if (stringBuffer == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  memcpy(stringBuffer + 1, data, text->mapping.size);
+
+  char *lastEnd = stringBuffer + 1 + text->mapping.size;
+  while (lastEnd > stringBuffer + 1 && lastEnd[-1] == '\r')
+    lastEnd--;
+  *lastEnd = '\0';
+
+  *shift = stringBuffer + 1 - data;
+  poeShiftTextStrings(text, *shift);
+
+  if (text->mapping.data != NULL)
+    poeUnmapFile(&text->mapping);
+  memset(&text->mapping, 0, sizeof(PoeFileMapping));
+
+  text->stringBuffer = stringBuffer;
+  text->stringBufferSize = lastEnd + 1 - stringBuffer;
+  text->stringBufferCapacity = capacity;
+
+  return POE_STATUS_OK;
+} // poeTextCopyMapping function end
+
+PoeStatus POE_API
+poeAppendText( PoeText *const text, FILE *const file, PoeTextAppend *const append ) {
+  assert(text != NULL);
+  assert(file != NULL);
+  assert(append != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_PARSE);
+
+  memset(append, 0, sizeof(PoeTextAppend));
+  append->firstStringIndex = text->stringCount;
+
+  fseek(file, 0, SEEK_END);
+  const size_t size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  // parsed texts have at least one string
+  if (text->stringBuffer != NULL ? text->stringBufferSize == 0 : text->stringCount == 0)
+    return POE_STATUS_BAD_FORMAT;
+
+  PoeStatus status;
+
+  // appended data and its terminating '\0' go after copied one
+  if (text->stringBuffer == NULL && !POE_CHECK(status = poeTextCopyMapping(text, text->mapping.size + size + 3, &append->dataShift)))
+    return status;
+
+  // geometric growth, so strings are shifted O(1) times per string on average
+  if (text->stringBufferSize + size + 1 > text->stringBufferCapacity) {
+    size_t capacity = text->stringBufferCapacity * 2;
+
+    if (capacity < text->stringBufferSize + size + 1)
+      capacity = text->stringBufferSize + size + 1;
+
+    char *const stringBuffer = (char *)poeArenaReallocate(text->arena, text->stringBuffer, text->stringBufferCapacity, capacity);
+
+    if (stringBuffer == NULL)
+      return POE_STATUS_BAD_ALLOC;
+
+    const ptrdiff_t shift = stringBuffer - text->stringBuffer;
+
+    poeShiftTextStrings(text, shift);
+    append->dataShift += shift;
+    text->stringBuffer = stringBuffer;
+    text->stringBufferCapacity = capacity;
+  }
+
+  // data is scanned in place: scanning never writes ahead of reading
+  char *const data = text->stringBuffer + text->stringBufferSize;
+  PoeScanResult scan = {0};
+
+  if (fread(data, 1, size, file) != size)
+    return POE_STATUS_IO_ERROR;
+
+  // scanned strings are temporary, so they are never allocated from text arena
+  if (!POE_CHECK(status = poeScanLines(data, data, size, &scan, NULL)))
+    return status;
+
+  // geometric growth too, so old strings are not copied by every append
+  if (text->stringCount + scan.stringCount > text->stringCapacity) {
+    size_t capacity = text->stringCapacity * 2;
+
+    if (capacity < text->stringCount + scan.stringCount)
+      capacity = text->stringCount + scan.stringCount;
+
+    PoeString *const strings = (PoeString *)poeArenaReallocate(
+      text->arena,
+      text->strings,
+      text->stringCapacity * sizeof(PoeString),
+      capacity * sizeof(PoeString)
+    );
+
+    if (strings == NULL) {
+      free(scan.strings);
+      return POE_STATUS_BAD_ALLOC;
+    }
+
+    text->strings = strings;
+    text->stringCapacity = capacity;
+  }
+
+  memcpy(text->strings + text->stringCount, scan.strings, scan.stringCount * sizeof(PoeString));
+  free(scan.strings);
+
+  data[scan.size] = '\0';
+  text->stringCount += scan.stringCount;
+  text->stringBufferSize += scan.size + 1;
+
+  return POE_STATUS_OK;
+} // poeAppendText function end
 
 void POE_API
 poeDestroyText( PoeText *const text ) {
   assert(text != NULL);
 
-  free(text->stringBuffer);
-  free(text->strings);
+  poeArenaFree(text->arena, text->stringBuffer);
+  poeArenaFree(text->arena, text->strings);
+
+  if (text->mapping.data != NULL)
+    poeUnmapFile(&text->mapping);
 } // poeDestroyText function end
 
 void POE_API
@@ -84,8 +531,10 @@ poeWriteText( FILE *const file, const PoeText *const text ) {
   assert(file != NULL);
   assert(text != NULL);
 
+  POE_STATS_PHASE(POE_STATS_PHASE_WRITE);
+
   for (size_t i = 0; i < text->stringCount; i++) {
-    fputs(text->strings[i].begin, file);
+    fwrite(text->strings[i].begin, 1, text->strings[i].end - text->strings[i].begin, file);
     fputc('\n', file);
   }
 } // poeWriteText function end
@@ -13,11 +13,9 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <time.h>
 
-// dynamic array
-#include <darr/darr.h>
-
 /// boolean type
 typedef int PoeBool;
 
@@ -38,35 +36,133 @@ typedef int PoeBool;
 /// Status representation structure
 typedef enum __PoeStatus {
   POE_DEFINE_COMMON_STATUS(POE_STATUS)
+  POE_STATUS_IO_ERROR   = 2, ///< File input/output error
+  POE_STATUS_BAD_FORMAT = 3, ///< Invalid or incompatible file format
 } PoeStatus;
 
 /// Status checking macro definition
 #define POE_CHECK(expr) ((POE_STATUS_OK) == (PoeStatus)(expr))
 
-/// string representation structure
+/**
+ * @brief string representation structure
+ * 
+ * @note strings are [begin, end) ranges and are NOT guaranteed to be '\0'-terminated (e.g. in mapped texts)
+ */
 typedef struct __PoeString {
   char *begin; ///< first character pointer
-  char *end;   ///< string end (points to '\0' string character)
+  char *end;   ///< string end (points to character after last string character)
 } PoeString;
 
+/// bump allocator construction functions may take (declared in poe_arena.h)
+typedef struct __PoeArena PoeArena;
+
+/// count of lines in Onegin stanza
+#define POE_STANZA_LINE_COUNT 14
+
+/// read-only file mapping representation structure
+typedef struct __PoeFileMapping {
+  const char * data; ///< mapped file data (NULL if file is empty)
+  size_t       size; ///< mapped file size
+} PoeFileMapping;
+
 /// text representation structure
 typedef struct __PoeText {
-  char      * stringBuffer; ///< string bulk allocation
-  PoeString * strings;      ///< text string pointer
-  size_t      stringCount;  ///< count of text strings
+  char           * stringBuffer;         ///< string bulk allocation (NULL if text is built over file mapping)
+  PoeString      * strings;              ///< text string pointer
+  size_t           stringCount;          ///< count of text strings
+  size_t           stringCapacity;       ///< count of allocated text strings
+  PoeFileMapping   mapping;              ///< file mapping text strings refer to (zeroed if text is not mapped)
+  size_t           stringBufferSize;     ///< count of used string buffer bytes (last string is followed by '\0' at stringBufferSize - 1, 0 if unknown)
+  size_t           stringBufferCapacity; ///< count of allocated string buffer bytes
+  PoeArena       * arena;                ///< arena string buffer and strings are allocated from (NULL if they are heap ones)
 } PoeText;
 
+/// text append result representation structure
+typedef struct __PoeTextAppend {
+  size_t    firstStringIndex; ///< index of first appended string (count of text strings before append)
+  ptrdiff_t dataShift;        ///< shift of text data that was there before append (0 if data was not moved)
+} PoeTextAppend;
+
+/**
+ * @brief file read-only mapping function
+ * 
+ * @param fileName name of file to map
+ * @param dst      mapping destination
+ * 
+ * @return POE_TRUE if mapped successfully, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeMapFile( const char *fileName, PoeFileMapping *dst );
+
+/**
+ * @brief file unmapping function
+ * 
+ * @param mapping mapping to unmap
+ */
+void POE_API
+poeUnmapFile( PoeFileMapping *mapping );
+
 
 /**
  * @brief text parsing function
  * 
  * @param file    file with text data
  * @param dstText parsed text
+ * @param arena   arena to allocate text from (NULL for heap)
  * 
  * @return POE_TRUE if parsed successfully, POE_FALSE otherwise
  */
 PoeStatus POE_API
-poeParseText( FILE *file, PoeText *dst );
+poeParseText( FILE *file, PoeText *dst, PoeArena *arena );
+
+/**
+ * @brief text parsing on several threads function
+ * 
+ * @param file        file with text data
+ * @param dst         parsed text
+ * @param threadCount count of threads to parse text on (0 for hardware thread count)
+ * @param arena       arena to allocate text from (NULL for heap)
+ * 
+ * @note result is the same as poeParseText one
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeParseTextParallel( FILE *file, PoeText *dst, size_t threadCount, PoeArena *arena );
+
+/**
+ * @brief text by file mapping parsing function
+ * 
+ * @param fileName name of file with text data
+ * @param dst      parsed text
+ * @param arena    arena to allocate text from (NULL for heap)
+ * 
+ * @note text strings refer to file mapping directly; text data is copied only if
+ *       file contains '\r' characters that are not trailing ones of their line
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeParseTextMapped( const char *fileName, PoeText *dst, PoeArena *arena );
+
+/**
+ * @brief text appending function
+ * 
+ * @param text   text to append strings to (parsed by poeParseText, poeParseTextParallel or poeParseTextMapped)
+ * @param file   file with data to append
+ * @param append append result (output)
+ * 
+ * @note data is parsed as by poeParseText and its strings are placed after text ones, so text
+ *       strings are in initial order only if they were before. String buffer and strings grow
+ *       geometrically, so cost is proportional to appended data size on average; if buffer is moved, old strings
+ *       are shifted by append->dataShift (pointers to them kept outside of text must be shifted too,
+ *       see poeAppendCompactText and poeOneginGeneratorAppend). Mapped text
+ *       data is copied to string buffer on first append. Text grows in arena it was parsed to.
+ * 
+ * @return operation status (POE_STATUS_BAD_FORMAT if text string buffer size is unknown)
+ */
+PoeStatus POE_API
+poeAppendText( PoeText *text, FILE *file, PoeTextAppend *append );
 
 /**
  * @brief text writing function
@@ -81,6 +177,8 @@ poeWriteText( FILE *file, const PoeText *text );
  * @brief text destructor
  * 
  * @param text text to destroy
+ * 
+ * @note arena text memory is freed with arena only
  */
 void POE_API
 poeDestroyText( PoeText *text );
@@ -0,0 +1,424 @@
+/**
+ * @file   poe/poe_external.cpp
+ * @author tiot2
+ * @brief  Poem processor external (out of memory) sort implementation module
+ */
+
+#include "poe.h"
+
+/// spilled sorted run representation structure
+typedef struct __PoeExternalRun {
+  FILE   * file;        ///< temporary file run is written to
+  size_t   stringCount; ///< count of run strings
+} PoeExternalRun;
+
+/// spilled run array (runs are few, so most sorts never allocate it)
+typedef PoeArray<PoeExternalRun, 16> PoeExternalRunArray;
+
+/// merged run cursor representation structure
+typedef struct __PoeExternalCursor {
+  PoeTextReader reader;    ///< run file reader
+  PoeText       batch;     ///< current string batch
+  size_t        position;  ///< current string index in batch
+  size_t        remaining; ///< count of run strings not yet merged (including current one)
+} PoeExternalCursor;
+
+/**
+ * @brief string writing function
+ * 
+ * @param file   file to write string to
+ * @param string string to write
+ * 
+ * @return POE_STATUS_OK if succeeded, POE_STATUS_IO_ERROR otherwise
+ */
+static PoeStatus
+poeExternalWriteString( FILE *const file, const PoeString *const string ) {
+  const size_t size = string->end - string->begin;
+
+  if (fwrite(string->begin, 1, size, file) != size || fputc('\n', file) == EOF)
+    return POE_STATUS_IO_ERROR;
+  return POE_STATUS_OK;
+} // poeExternalWriteString function end
+
+/**
+ * @brief run sorting and spilling function
+ * 
+ * @param run       run to sort and spill (emptied if succeeded)
+ * @param compareFn compare function
+ * @param runs      spilled run array to push run to
+ * 
+ * @return operation status
+ */
+static PoeStatus
+poeExternalSpillRun( PoeText *const run, const PoeStringCompareFn compareFn, PoeExternalRunArray *const runs ) {
+  PoeExternalRun spilled = {
+    .stringCount = run->stringCount,
+  };
+
+  poeSortText(run, compareFn);
+
+  if (tmpfile_s(&spilled.file) != 0 || spilled.file == NULL)
+    return POE_STATUS_IO_ERROR;
+
+  for (size_t i = 0; i < run->stringCount; i++)
+    if (!POE_CHECK(poeExternalWriteString(spilled.file, run->strings + i))) {
+      fclose(spilled.file);
+      return POE_STATUS_IO_ERROR;
+    }
+
+  if (fflush(spilled.file) != 0) {
+    fclose(spilled.file);
+    return POE_STATUS_IO_ERROR;
+  }
+
+  if (!runs->push(spilled)) {
+    fclose(spilled.file);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  run->stringCount = 0;
+
+  return POE_STATUS_OK;
+} // poeExternalSpillRun function end
+
+/**
+ * @brief cursor to next string moving function
+ * 
+ * @param cursor cursor to move
+ * 
+ * @return operation status
+ */
+static PoeStatus
+poeExternalCursorNext( PoeExternalCursor *const cursor ) {
+  if (cursor->remaining > 0)
+    cursor->remaining--;
+  cursor->position++;
+
+  if (cursor->remaining == 0 || cursor->position < cursor->batch.stringCount)
+    return POE_STATUS_OK;
+
+  cursor->position = 0;
+  PoeStatus status = poeTextReaderNext(&cursor->reader, &cursor->batch);
+
+  // run file is shorter than expected
+  if (POE_CHECK(status) && cursor->batch.stringCount == 0)
+    status = POE_STATUS_IO_ERROR;
+
+  return status;
+} // poeExternalCursorNext function end
+
+/// loser tree representation structure
+typedef struct __PoeLoserTree {
+  PoeExternalCursor  * cursors;     ///< merged run cursors (leaves)
+  size_t             * losers;      ///< node losers (losers[0] is overall winner)
+  size_t               cursorCount; ///< count of cursors
+  PoeStringCompareFn   compareFn;   ///< compare function
+} PoeLoserTree;
+
+/**
+ * @brief loser tree cursors comparing function
+ * 
+ * @param tree  loser tree
+ * @param lhs   left hand side cursor index
+ * @param rhs   right hand side cursor index
+ * 
+ * @return POE_TRUE if lhs cursor string goes before rhs one, POE_FALSE otherwise
+ * 
+ * @note exhausted cursors go after all the others, equal strings are ordered by cursor index
+ */
+static PoeBool
+poeLoserTreeLess( const PoeLoserTree *const tree, const size_t lhs, const size_t rhs ) {
+  const PoeExternalCursor *const left = tree->cursors + lhs;
+  const PoeExternalCursor *const right = tree->cursors + rhs;
+
+  if (left->remaining == 0 || right->remaining == 0)
+    return left->remaining != 0 || (right->remaining == 0 && lhs < rhs);
+
+  const PoeOrdering ordering = tree->compareFn(left->batch.strings + left->position, right->batch.strings + right->position);
+
+  return ordering == POE_ORDERING_LESS || (ordering == POE_ORDERING_EQUAL && lhs < rhs);
+} // poeLoserTreeLess function end
+
+/**
+ * @brief loser tree building function
+ * 
+ * @param tree    tree to build
+ * @param winners temporary node winner buffer (cursorCount elements)
+ */
+static void
+poeLoserTreeBuild( PoeLoserTree *const tree, size_t *const winners ) {
+  const size_t count = tree->cursorCount;
+
+  // node n has children 2n and 2n + 1, leaves count..2count-1 correspond to cursors
+  for (size_t node = count - 1; node >= 1; node--) {
+    const size_t left = 2 * node < count ? winners[2 * node] : 2 * node - count;
+    const size_t right = 2 * node + 1 < count ? winners[2 * node + 1] : 2 * node + 1 - count;
+
+    if (poeLoserTreeLess(tree, left, right)) {
+      winners[node] = left;
+      tree->losers[node] = right;
+    } else {
+      winners[node] = right;
+      tree->losers[node] = left;
+    }
+  }
+
+  tree->losers[0] = count == 1 ? 0 : winners[1];
+} // poeLoserTreeBuild function end
+
+/**
+ * @brief loser tree after winner cursor movement replaying function
+ * 
+ * @param tree tree to replay
+ */
+static void
+poeLoserTreeReplay( PoeLoserTree *const tree ) {
+  size_t winner = tree->losers[0];
+
+  for (size_t node = (winner + tree->cursorCount) / 2; node >= 1; node /= 2)
+    if (poeLoserTreeLess(tree, tree->losers[node], winner)) {
+      const size_t tmp = tree->losers[node];
+
+      tree->losers[node] = winner;
+      winner = tmp;
+    }
+
+  tree->losers[0] = winner;
+} // poeLoserTreeReplay function end
+
+/**
+ * @brief spilled runs merging function
+ * 
+ * @param runs       runs to merge (closed by function)
+ * @param runCount   count of runs
+ * @param output     file to write merged strings to
+ * @param compareFn  compare function
+ * @param windowSize run reader window size
+ * 
+ * @return operation status
+ */
+static PoeStatus
+poeExternalMerge(
+  PoeExternalRun *const runs,
+  const size_t runCount,
+  FILE *const output,
+  const PoeStringCompareFn compareFn,
+  const size_t windowSize
+) {
+  PoeExternalCursor *cursors = (PoeExternalCursor *)poeArenaAllocateZeroed(NULL, runCount, sizeof(PoeExternalCursor));
+  size_t *nodes = (size_t *)poeArenaAllocateZeroed(NULL, runCount * 2, sizeof(size_t));
+  size_t openedCount = 0;
+  PoeStatus status = POE_STATUS_OK;
+
+  if (cursors == NULL || nodes == NULL)
+    status = POE_STATUS_BAD_ALLOC;
+
+  for (; POE_CHECK(status) && openedCount < runCount; openedCount++) {
+    PoeExternalCursor *const cursor = cursors + openedCount;
+
+    if (fseek(runs[openedCount].file, 0, SEEK_SET) != 0) {
+      status = POE_STATUS_IO_ERROR;
+      break;
+    }
+
+    if (!POE_CHECK(status = poeOpenTextReader(runs[openedCount].file, windowSize, 0, &cursor->reader)))
+      break;
+
+    cursor->remaining = runs[openedCount].stringCount;
+    cursor->position = 0;
+
+    if (POE_CHECK(status = poeTextReaderNext(&cursor->reader, &cursor->batch)) && cursor->batch.stringCount == 0 && cursor->remaining != 0)
+      status = POE_STATUS_IO_ERROR;
+  }
+
+  if (POE_CHECK(status)) {
+    PoeLoserTree tree = {
+      .cursors = cursors,
+      .losers = nodes,
+      .cursorCount = runCount,
+      .compareFn = compareFn,
+    };
+
+    poeLoserTreeBuild(&tree, nodes + runCount);
+
+    while (POE_CHECK(status)) {
+      PoeExternalCursor *const winner = cursors + tree.losers[0];
+
+      if (winner->remaining == 0)
+        break;
+
+      if (!POE_CHECK(status = poeExternalWriteString(output, winner->batch.strings + winner->position)))
+        break;
+
+      if (!POE_CHECK(status = poeExternalCursorNext(winner)))
+        break;
+
+      poeLoserTreeReplay(&tree);
+    }
+  }
+
+  for (size_t i = 0; i < openedCount; i++)
+    poeCloseTextReader(&cursors[i].reader);
+
+  for (size_t i = 0; i < runCount; i++) {
+    fclose(runs[i].file);
+    runs[i].file = NULL;
+  }
+
+  free(nodes);
+  free(cursors);
+
+  return status;
+} // poeExternalMerge function end
+
+PoeStatus POE_API
+poeSortFileExternal(
+  FILE *const input,
+  FILE *const output,
+  const PoeStringCompareFn compareFn,
+  const PoeExternalSortParams *const params,
+  PoeExternalSortStat *const stat
+) {
+  assert(input != NULL);
+  assert(output != NULL);
+  assert(compareFn != NULL);
+  assert(compareFn != poeCompareInitialOrder);
+
+  const size_t memoryBudget = params != NULL && params->memoryBudget != 0 ? params->memoryBudget : POE_EXTERNAL_DEFAULT_MEMORY_BUDGET;
+  const size_t fanIn = params != NULL && params->fanIn >= 2 ? params->fanIn : POE_EXTERNAL_DEFAULT_FAN_IN;
+  const size_t mergeWindowSize = memoryBudget / fanIn > POE_EXTERNAL_MIN_MERGE_WINDOW_SIZE ? memoryBudget / fanIn : POE_EXTERNAL_MIN_MERGE_WINDOW_SIZE;
+
+  PoeExternalSortStat sortStat = {0};
+  PoeTextReader reader;
+  PoeStatus status = poeOpenTextReader(input, 0, 0, &reader);
+
+  if (!POE_CHECK(status))
+    return status;
+
+  // each string takes at least sizeof(PoeString) bytes of budget
+  size_t runBufferCapacity = memoryBudget;
+  const size_t runStringCapacity = memoryBudget / sizeof(PoeString) + 1;
+  char *runBuffer = (char *)poeArenaAllocate(NULL, runBufferCapacity);
+  PoeString *runStrings = (PoeString *)poeArenaAllocateZeroed(NULL, runStringCapacity, sizeof(PoeString));
+  PoeExternalRunArray runs;
+
+  PoeText run = {
+    .strings = runStrings,
+  };
+  size_t runDataSize = 0;
+
+  if (runBuffer == NULL || runStrings == NULL)
+    status = POE_STATUS_BAD_ALLOC;
+
+  // run generation
+  while (POE_CHECK(status)) {
+    PoeText batch;
+
+    if (!POE_CHECK(status = poeTextReaderNext(&reader, &batch)) || batch.stringCount == 0)
+      break;
+
+    for (size_t i = 0; i < batch.stringCount; i++) {
+      const size_t size = batch.strings[i].end - batch.strings[i].begin;
+
+      if (run.stringCount != 0 && runDataSize + size + (run.stringCount + 1) * sizeof(PoeString) > memoryBudget) {
+        sortStat.stringCount += run.stringCount;
+        sortStat.runCount++;
+
+        if (!POE_CHECK(status = poeExternalSpillRun(&run, compareFn, &runs)))
+          break;
+        runDataSize = 0;
+      }
+
+      // string longer than budget is placed to run alone
+      if (size > runBufferCapacity) {
+        char *const newRunBuffer = (char *)poeArenaReallocate(NULL, runBuffer, runBufferCapacity, size);
+
+        if (newRunBuffer == NULL) {
+          status = POE_STATUS_BAD_ALLOC;
+          break;
+        }
+
+        runBuffer = newRunBuffer;
+        runBufferCapacity = size;
+      }
+
+      memcpy(runBuffer + runDataSize, batch.strings[i].begin, size);
+      run.strings[run.stringCount].begin = runBuffer + runDataSize;
+      run.strings[run.stringCount].end = runBuffer + runDataSize + size;
+      run.stringCount++;
+      runDataSize += size;
+    }
+  }
+
+  if (POE_CHECK(status) && run.stringCount != 0) {
+    sortStat.stringCount += run.stringCount;
+    sortStat.runCount++;
+
+    if (runs.count != 0) {
+      status = poeExternalSpillRun(&run, compareFn, &runs);
+    } else {
+      // whole text fits in single run
+      poeSortText(&run, compareFn);
+
+      for (size_t i = 0; POE_CHECK(status) && i < run.stringCount; i++)
+        status = poeExternalWriteString(output, run.strings + i);
+    }
+  }
+
+  poeCloseTextReader(&reader);
+  free(runStrings);
+  free(runBuffer);
+
+  // merge passes, each one merges groups of fanIn runs
+  size_t runCount = runs.count;
+
+  while (POE_CHECK(status) && runCount > 0) {
+    sortStat.mergePassCount++;
+
+    if (runCount <= fanIn) {
+      status = poeExternalMerge(runs.elements, runCount, output, compareFn, mergeWindowSize);
+      break;
+    }
+
+    size_t mergedCount = 0;
+
+    for (size_t first = 0; first < runCount; first += fanIn) {
+      const size_t groupSize = runCount - first < fanIn ? runCount - first : fanIn;
+      PoeExternalRun merged = {0};
+
+      for (size_t i = first; i < first + groupSize; i++)
+        merged.stringCount += runs[i].stringCount;
+
+      if (tmpfile_s(&merged.file) != 0 || merged.file == NULL) {
+        status = POE_STATUS_IO_ERROR;
+        break;
+      }
+
+      if (POE_CHECK(status = poeExternalMerge(runs.elements + first, groupSize, merged.file, compareFn, mergeWindowSize)) && fflush(merged.file) != 0)
+        status = POE_STATUS_IO_ERROR;
+
+      // merged runs are closed, so their slots are reused
+      runs[mergedCount++] = merged;
+
+      if (!POE_CHECK(status))
+        break;
+    }
+
+    runCount = mergedCount;
+  }
+
+  // merge closes runs, so files are left open in case of failure only
+  for (size_t i = 0; i < runs.count; i++)
+    if (runs[i].file != NULL)
+      fclose(runs[i].file);
+
+  if (POE_CHECK(status) && fflush(output) != 0)
+    status = POE_STATUS_IO_ERROR;
+
+  if (stat != NULL)
+    *stat = sortStat;
+
+  return status;
+} // poeSortFileExternal function end
+
+// poe_external.cpp file end
@@ -0,0 +1,61 @@
+/**
+ * @file   poe/poe_external.h
+ * @author tiot2
+ * @brief  Poem processor external (out of memory) sort declaration module
+ */
+
+#ifndef POE_EXTERNAL_H_
+#define POE_EXTERNAL_H_
+
+#include "poe_reader.h"
+#include "poe_compare.h"
+
+/// default external sort memory budget
+#define POE_EXTERNAL_DEFAULT_MEMORY_BUDGET ((size_t)64 << 20)
+
+/// default count of runs merged at once
+#define POE_EXTERNAL_DEFAULT_FAN_IN ((size_t)16)
+
+/// minimal size of merged run read window
+#define POE_EXTERNAL_MIN_MERGE_WINDOW_SIZE ((size_t)4 << 10)
+
+/// external sort parameters representation structure
+typedef struct __PoeExternalSortParams {
+  size_t memoryBudget; ///< maximal size of in-memory run (string bytes and PoeString array), 0 for POE_EXTERNAL_DEFAULT_MEMORY_BUDGET
+  size_t fanIn;        ///< maximal count of runs merged at once (at least 2), 0 for POE_EXTERNAL_DEFAULT_FAN_IN
+} PoeExternalSortParams;
+
+/// external sort statistics representation structure
+typedef struct __PoeExternalSortStat {
+  size_t stringCount;    ///< count of sorted strings
+  size_t runCount;       ///< count of initial (in-memory sorted) runs
+  size_t mergePassCount; ///< count of merge passes (0 if text fit in single run)
+} PoeExternalSortStat;
+
+/**
+ * @brief file by external merge sort sorting function
+ * 
+ * @param input     file to read text from (must be opened in binary mode)
+ * @param output    file to write sorted text to (strings are written as poeWriteText does)
+ * @param compareFn compare function (must not depend on string addresses, so poeCompareInitialOrder is not supported)
+ * @param params    sort parameters (NULL for defaults)
+ * @param stat      sort statistics (output, may be NULL)
+ * 
+ * @note input is split into runs of at most memoryBudget bytes, each run is sorted by poeSortText
+ *       and spilled to temporary file, runs are merged by loser tree then. Result is the same as
+ *       poeParseText + poeSortText + poeWriteText one (up to order of equal strings).
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeSortFileExternal(
+  FILE *input,
+  FILE *output,
+  PoeStringCompareFn compareFn,
+  const PoeExternalSortParams *params,
+  PoeExternalSortStat *stat
+);
+
+#endif // !defined(POE_EXTERNAL_H_)
+
+// poe_external.h file end
@@ -5,6 +5,7 @@
  */
 
 #include "poe_generator.h"
+#include "poe_arena.h"
 
 /**
  * @brief last characters getting function
@@ -17,117 +18,163 @@ static uint32_t
 poeGeneratorGetStringLastCharacters( const PoeString *const string ) {
   assert(string != NULL);
 
-  char buffer[4] = {0};
+  const unsigned char *const weights = poeCompareCurrentCollation->weights;
+  unsigned char buffer[4] = {0};
   size_t bufferSize = 0;
-  unsigned char *iter = (unsigned char *)string->end - 1;
+  const unsigned char *iter = (const unsigned char *)string->end;
+  const unsigned char *const begin = (const unsigned char *)string->begin;
 
-  while (bufferSize < 3 && *iter != '\0') {
-    if (poeCompareCheckCharacterComparability(*iter))
-      buffer[bufferSize++] = poeCompareProcessCharacter(*iter);
-    iter--;
+  // skipped characters have zero weight, so they are overwritten by next comparable one
+  while (bufferSize < 3 && iter > begin) {
+    const unsigned char weight = weights[*--iter];
+
+    buffer[bufferSize] = weight;
+    bufferSize += weight != 0;
   }
 
   return *(uint32_t *)buffer;
 } // poeGeneratorGetStringLastCharacters function end
 
-/// statistics entry representation structure
-typedef struct __PoeEndingStatEntry {
-  uint32_t last;  ///< last characters
-  size_t   count; ///< count of strnigs
-} PoeEndingStatEntry;
+/// ending hash table slot representation structure
+typedef struct __PoeEndingSlot {
+  uint32_t last;        ///< last characters
+  uint32_t endingIndex; ///< index of ending plus one (0 if slot is empty)
+} PoeEndingSlot;
+
+/// minimal ending hash table size logarithm
+#define POE_GENERATOR_MIN_HASH_BITS 4
 
 /**
- * @brief ending statistics getting function
+ * @brief last characters hashing function
  * 
- * @param text text to get ending statistics of
+ * @param last last characters
+ * @param bits hash table size logarithm
  * 
- * @return ending statistics dynamic array
+ * @return hash table slot index
  */
-static PoeEndingStatEntry *
-poeGetEndingStat( const PoeText *const text ) {
+static inline size_t
+poeGeneratorHashLast( const uint32_t last, const unsigned int bits ) {
+  // fibonacci hashing: high bits of product are well mixed
+  return (size_t)(((uint64_t)last * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+} // poeGeneratorHashLast function end
+
+/**
+ * @brief text string endings indexing function
+ * 
+ * @param text          text to index endings of
+ * @param stringEndings ending index of every text string (output, text->stringCount elements)
+ * @param endingLasts   last characters of every ending in order of first occurrence (output, text->stringCount elements)
+ * 
+ * @note hash table is sized for at least twice as many slots as strings, so it never grows and probes stay short
+ * 
+ * @return count of distinct endings, SIZE_MAX if allocation failed
+ */
+static size_t
+poeGeneratorIndexEndings( const PoeText *const text, uint32_t *const stringEndings, uint32_t *const endingLasts ) {
   assert(text != NULL);
+  assert(stringEndings != NULL);
+  assert(endingLasts != NULL);
 
-  PoeEndingStatEntry *entries = (PoeEndingStatEntry *)darrCreate(sizeof(PoeEndingStatEntry), 0);
-  size_t entryCount = 0;
+  unsigned int bits = POE_GENERATOR_MIN_HASH_BITS;
 
-  if (entries == NULL)
-    return NULL;
+  while (((size_t)1 << bits) < text->stringCount * 2)
+    bits++;
 
-  for (size_t stringIndex = 0; stringIndex < text->stringCount; stringIndex++) {
-    uint32_t last = poeGeneratorGetStringLastCharacters(text->strings + stringIndex);
-    PoeBool found = POE_FALSE;
-
-    for (size_t entryIndex = 0; entryIndex < entryCount; entryIndex++) {
-      if (entries[entryIndex].last == last) {
-        entries[entryIndex].count++;
-        found = POE_TRUE;
-        break;
-      }
-    }
+  const size_t mask = ((size_t)1 << bits) - 1;
+
+  PoeEndingSlot *slots = (PoeEndingSlot *)poeArenaAllocateZeroed(NULL, mask + 1, sizeof(PoeEndingSlot));
 
-    // insert ending in statistics
-    if (!found) {
-      PoeEndingStatEntry entry = {
-        .last = last,
-        .count = 1,
-      };
+  if (slots == NULL)
+    return SIZE_MAX;
 
-      if ((entries = (PoeEndingStatEntry *)darrPush(entries, &entry)) == NULL)
-        return NULL;
+  size_t endingCount = 0;
 
-      entryCount++;
+  for (size_t stringIndex = 0; stringIndex < text->stringCount; stringIndex++) {
+    const uint32_t last = poeGeneratorGetStringLastCharacters(text->strings + stringIndex);
+    size_t slotIndex = poeGeneratorHashLast(last, bits);
+
+    // linear probing until ending or empty slot is found
+    while (slots[slotIndex].endingIndex != 0 && slots[slotIndex].last != last)
+      slotIndex = (slotIndex + 1) & mask;
+
+    if (slots[slotIndex].endingIndex == 0) {
+      slots[slotIndex].last = last;
+      slots[slotIndex].endingIndex = (uint32_t)++endingCount;
+      endingLasts[endingCount - 1] = last;
     }
+
+    stringEndings[stringIndex] = slots[slotIndex].endingIndex - 1;
   }
 
-  return entries;
-} // poeGetEndingStat function end
+  free(slots);
+
+  return endingCount;
+} // poeGeneratorIndexEndings function end
 
 PoeBool POE_API
 poeCreateGenerator(
   const PoeText *const text,
-  PoeGenerator *const generator
+  PoeGenerator *const generator,
+  PoeArena *const arena
 ) {
   assert(text != NULL);
   assert(generator != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
   memset(generator, 0, sizeof(PoeGenerator));
 
-  PoeEndingStatEntry *endingStat = poeGetEndingStat(text);
-  if (endingStat == NULL)
+  // string and ending indices are 32-bit
+  if (text->stringCount >= UINT32_MAX)
+    return POE_FALSE;
+
+  uint32_t *stringEndings = (uint32_t *)poeArenaAllocate(NULL, (text->stringCount * 2 + 1) * sizeof(uint32_t));
+  if (stringEndings == NULL)
     return POE_FALSE;
-  size_t endingCount = darrGetSize(endingStat);
+  uint32_t *const endingLasts = stringEndings + text->stringCount;
 
-  PoeEnding *endings = (PoeEnding *)calloc(endingCount, sizeof(PoeEnding));
+  const size_t endingCount = poeGeneratorIndexEndings(text, stringEndings, endingLasts);
+  if (endingCount == SIZE_MAX) {
+    free(stringEndings);
+    return POE_FALSE;
+  }
+
+  PoeEnding *endings = (PoeEnding *)poeArenaAllocateZeroed(arena, endingCount, sizeof(PoeEnding));
   if (endings == NULL) {
-    darrDestroy(endingStat);
+    free(stringEndings);
     return POE_FALSE;
   }
 
-  PoeString **stringPool = (PoeString **)calloc(text->stringCount, sizeof(PoeString *));
+  uint32_t *stringPool = (uint32_t *)poeArenaAllocate(arena, text->stringCount * sizeof(uint32_t));
   if (stringPool == NULL) {
-    darrDestroy(endingStat);
-    free(endings);
+    free(stringEndings);
+    poeArenaFree(arena, endings);
     return POE_FALSE;
   }
 
-  PoeString **poolIter = stringPool;
+  // counting pass: ending string lists are laid out in pool in order of first ending occurrence
+  for (size_t i = 0; i < text->stringCount; i++)
+    endings[stringEndings[i]].stringCount++;
+
+  uint32_t poolOffset = 0;
 
   for (size_t endingIndex = 0; endingIndex < endingCount; endingIndex++) {
-    endings[endingIndex].last = endingStat[endingIndex].last;
-    endings[endingIndex].strings = poolIter;
-    poolIter += endingStat[endingIndex].count;
+    endings[endingIndex].last = endingLasts[endingIndex];
+    endings[endingIndex].poolOffset = poolOffset;
+    poolOffset += endings[endingIndex].stringCount;
+    endings[endingIndex].stringCount = 0;
   }
 
   for (size_t i = 0; i < text->stringCount; i++) {
-    uint32_t last = poeGeneratorGetStringLastCharacters(text->strings + i);
+    PoeEnding *const ending = endings + stringEndings[i];
 
-    for (size_t ei = 0; ei < endingCount; ei++)
-      if (endings[ei].last == last) {
-        endings[ei].strings[endings[ei].stringCount++] = text->strings + i;
-        break;
-      }
+    stringPool[ending->poolOffset + ending->stringCount++] = (uint32_t)i;
   }
 
+  free(stringEndings);
+
   generator->text        = text;
+  generator->arena       = arena;
   generator->stringPool  = stringPool;
   generator->endings     = endings;
   generator->endingCount = endingCount;
@@ -135,43 +182,376 @@ poeCreateGenerator(
   return POE_TRUE;
 } // poeGeneratorCreate function end
 
+/// generator ending lists growth state representation structure
+struct __PoeGeneratorGrowth {
+  PoeEnding     * endings;            ///< endings
+  uint32_t      * stringCapacities;   ///< count of pool elements reserved for every ending string list
+  size_t          endingCapacity;     ///< count of allocated endings
+  uint32_t      * stringPool;         ///< string pool (contains unused space of relocated lists)
+  size_t          stringPoolSize;     ///< count of reserved string pool elements
+  size_t          stringPoolCapacity; ///< count of allocated string pool elements
+  PoeEndingSlot * slots;              ///< ending hash table (at least twice as many slots as allocated endings)
+  unsigned int    slotBits;           ///< ending hash table size logarithm
+};
+
+/// minimal count of pool elements reserved for appended ending string list
+#define POE_GENERATOR_MIN_LIST_CAPACITY 4
+
+/**
+ * @brief growth state ending hash table building function
+ * 
+ * @param growth      growth state (endings and endingCapacity must be set)
+ * @param endingCount count of endings
+ * 
+ * @return POE_TRUE if built, POE_FALSE if allocation failed (old table is kept then)
+ */
+static PoeBool
+poeGeneratorGrowthBuildSlots( PoeGeneratorGrowth *const growth, const size_t endingCount ) {
+  unsigned int bits = POE_GENERATOR_MIN_HASH_BITS;
+
+  while (((size_t)1 << bits) < growth->endingCapacity * 2)
+    bits++;
+
+  const size_t mask = ((size_t)1 << bits) - 1;
+
+  PoeEndingSlot *const slots = (PoeEndingSlot *)poeArenaAllocateZeroed(NULL, mask + 1, sizeof(PoeEndingSlot));
+
+  if (slots == NULL)
+    return POE_FALSE;
+
+  for (size_t endingIndex = 0; endingIndex < endingCount; endingIndex++) {
+    const uint32_t last = growth->endings[endingIndex].last;
+    size_t slotIndex = poeGeneratorHashLast(last, bits);
+
+    while (slots[slotIndex].endingIndex != 0)
+      slotIndex = (slotIndex + 1) & mask;
+
+    slots[slotIndex].last = last;
+    slots[slotIndex].endingIndex = (uint32_t)endingIndex + 1;
+  }
+
+  free(growth->slots);
+  growth->slots = slots;
+  growth->slotBits = bits;
+
+  return POE_TRUE;
+} // poeGeneratorGrowthBuildSlots function end
+
+/**
+ * @brief generator growth state destroy function
+ * 
+ * @param growth growth state to destroy (may be NULL)
+ */
+static void
+poeGeneratorDestroyGrowth( PoeGeneratorGrowth *const growth ) {
+  if (growth == NULL)
+    return;
+
+  free(growth->endings);
+  free(growth->stringCapacities);
+  free(growth->stringPool);
+  free(growth->slots);
+  free(growth);
+} // poeGeneratorDestroyGrowth function end
+
+/**
+ * @brief generator growth state creation function
+ * 
+ * @param generator generator to create growth state of (its tables are replaced by growable copies)
+ * 
+ * @return POE_TRUE if created, POE_FALSE if allocation failed (generator is not changed then)
+ */
+static PoeBool
+poeGeneratorCreateGrowth( PoeGenerator *const generator ) {
+  PoeGeneratorGrowth *const growth = (PoeGeneratorGrowth *)poeArenaAllocateZeroed(NULL, 1, sizeof(PoeGeneratorGrowth));
+
+  if (growth == NULL)
+    return POE_FALSE;
+
+  size_t stringPoolSize = 0;
+
+  for (size_t i = 0; i < generator->endingCount; i++)
+    if (stringPoolSize < (size_t)generator->endings[i].poolOffset + generator->endings[i].stringCount)
+      stringPoolSize = (size_t)generator->endings[i].poolOffset + generator->endings[i].stringCount;
+
+  growth->endingCapacity = generator->endingCount * 2 + POE_GENERATOR_MIN_LIST_CAPACITY;
+  growth->stringPoolSize = stringPoolSize;
+  growth->stringPoolCapacity = stringPoolSize * 2 + POE_GENERATOR_MIN_LIST_CAPACITY;
+
+  growth->endings = (PoeEnding *)poeArenaAllocate(NULL, growth->endingCapacity * sizeof(PoeEnding));
+  growth->stringCapacities = (uint32_t *)poeArenaAllocate(NULL, growth->endingCapacity * sizeof(uint32_t));
+  growth->stringPool = (uint32_t *)poeArenaAllocate(NULL, growth->stringPoolCapacity * sizeof(uint32_t));
+
+  if (growth->endings == NULL || growth->stringCapacities == NULL || growth->stringPool == NULL) {
+    poeGeneratorDestroyGrowth(growth);
+    return POE_FALSE;
+  }
+
+  memcpy(growth->endings, generator->endings, generator->endingCount * sizeof(PoeEnding));
+  memcpy(growth->stringPool, generator->stringPool, stringPoolSize * sizeof(uint32_t));
+
+  // created lists are packed, so every one is full
+  for (size_t i = 0; i < generator->endingCount; i++)
+    growth->stringCapacities[i] = generator->endings[i].stringCount;
+
+  if (!poeGeneratorGrowthBuildSlots(growth, generator->endingCount)) {
+    poeGeneratorDestroyGrowth(growth);
+    return POE_FALSE;
+  }
+
+  if (generator->snapshot.data != NULL)
+    poeUnmapFile(&generator->snapshot);
+  else {
+    poeArenaFree(generator->arena, (void *)generator->stringPool);
+    poeArenaFree(generator->arena, (void *)generator->endings);
+  }
+  memset(&generator->snapshot, 0, sizeof(PoeFileMapping));
+
+  generator->growth = growth;
+  generator->endings = growth->endings;
+  generator->stringPool = growth->stringPool;
+
+  return POE_TRUE;
+} // poeGeneratorCreateGrowth function end
+
+/**
+ * @brief growth state string pool reservation function
+ * 
+ * @param growth growth state
+ * @param size   count of pool elements to reserve after reserved ones
+ * 
+ * @return offset of reserved elements, UINT32_MAX if allocation failed or pool is too large
+ */
+static uint32_t
+poeGeneratorReservePool( PoeGeneratorGrowth *const growth, const size_t size ) {
+  if (growth->stringPoolSize + size >= UINT32_MAX)
+    return UINT32_MAX;
+
+  if (growth->stringPoolSize + size > growth->stringPoolCapacity) {
+    size_t capacity = growth->stringPoolCapacity * 2;
+
+    if (capacity < growth->stringPoolSize + size)
+      capacity = growth->stringPoolSize + size;
+
+    uint32_t *const stringPool = (uint32_t *)poeArenaReallocate(
+      NULL,
+      growth->stringPool,
+      growth->stringPoolCapacity * sizeof(uint32_t),
+      capacity * sizeof(uint32_t)
+    );
+
+    if (stringPool == NULL)
+      return UINT32_MAX;
+
+    growth->stringPool = stringPool;
+    growth->stringPoolCapacity = capacity;
+  }
+
+  const uint32_t offset = (uint32_t)growth->stringPoolSize;
+
+  growth->stringPoolSize += size;
+  return offset;
+} // poeGeneratorReservePool function end
+
+/**
+ * @brief generator ending capacity doubling function
+ * 
+ * @param generator generator with growth state
+ * 
+ * @return POE_TRUE if grown, POE_FALSE if allocation failed
+ */
+static PoeBool
+poeGeneratorGrowEndings( PoeGenerator *const generator ) {
+  PoeGeneratorGrowth *const growth = generator->growth;
+  const size_t endingCapacity = growth->endingCapacity * 2;
+
+  PoeEnding *const endings = (PoeEnding *)poeArenaReallocate(
+    NULL,
+    growth->endings,
+    growth->endingCapacity * sizeof(PoeEnding),
+    endingCapacity * sizeof(PoeEnding)
+  );
+
+  if (endings == NULL)
+    return POE_FALSE;
+
+  generator->endings = growth->endings = endings;
+
+  uint32_t *const stringCapacities = (uint32_t *)poeArenaReallocate(
+    NULL,
+    growth->stringCapacities,
+    growth->endingCapacity * sizeof(uint32_t),
+    endingCapacity * sizeof(uint32_t)
+  );
+
+  if (stringCapacities == NULL)
+    return POE_FALSE;
+
+  growth->stringCapacities = stringCapacities;
+  growth->endingCapacity = endingCapacity;
+
+  return poeGeneratorGrowthBuildSlots(growth, generator->endingCount);
+} // poeGeneratorGrowEndings function end
+
+/**
+ * @brief ending string list string adding function
+ * 
+ * @param growth      growth state
+ * @param endingIndex index of ending to add string to
+ * @param stringIndex index of text string to add
+ * 
+ * @note full list is extended in place if it is last in pool, and relocated to pool end with
+ *       doubled capacity otherwise, so every string is moved O(1) times on average
+ * 
+ * @return POE_TRUE if added, POE_FALSE otherwise
+ */
+static PoeBool
+poeGeneratorGrowthAddString( PoeGeneratorGrowth *const growth, const size_t endingIndex, const uint32_t stringIndex ) {
+  PoeEnding *const ending = growth->endings + endingIndex;
+  const uint32_t capacity = growth->stringCapacities[endingIndex];
+
+  if (ending->stringCount == capacity) {
+    const size_t newCapacity = capacity < POE_GENERATOR_MIN_LIST_CAPACITY ? POE_GENERATOR_MIN_LIST_CAPACITY : (size_t)capacity * 2;
+
+    if ((size_t)ending->poolOffset + capacity == growth->stringPoolSize && capacity != 0) {
+      if (poeGeneratorReservePool(growth, newCapacity - capacity) == UINT32_MAX)
+        return POE_FALSE;
+    } else {
+      const uint32_t poolOffset = poeGeneratorReservePool(growth, newCapacity);
+
+      if (poolOffset == UINT32_MAX)
+        return POE_FALSE;
+
+      memcpy(growth->stringPool + poolOffset, growth->stringPool + ending->poolOffset, ending->stringCount * sizeof(uint32_t));
+      ending->poolOffset = poolOffset;
+    }
+
+    growth->stringCapacities[endingIndex] = (uint32_t)newCapacity;
+  }
+
+  growth->stringPool[ending->poolOffset + ending->stringCount++] = stringIndex;
+  return POE_TRUE;
+} // poeGeneratorGrowthAddString function end
+
+PoeBool POE_API
+poeGeneratorAppend( PoeGenerator *const generator, const PoeTextAppend *const append ) {
+  assert(generator != NULL);
+  assert(generator->text != NULL);
+  assert(append != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
+  const PoeText *const text = generator->text;
+
+  if (append->firstStringIndex == text->stringCount)
+    return POE_TRUE;
+
+  // string and ending indices are 32-bit
+  if (text->stringCount >= UINT32_MAX)
+    return POE_FALSE;
+
+  if (generator->growth == NULL && !poeGeneratorCreateGrowth(generator))
+    return POE_FALSE;
+
+  PoeGeneratorGrowth *const growth = generator->growth;
+  PoeBool ok = POE_TRUE;
+
+  for (size_t stringIndex = append->firstStringIndex; ok && stringIndex < text->stringCount; stringIndex++) {
+    // hash table is rebuilt on growth, so slot is searched after it
+    if (generator->endingCount == growth->endingCapacity && !poeGeneratorGrowEndings(generator))
+      return POE_FALSE;
+
+    const uint32_t last = poeGeneratorGetStringLastCharacters(text->strings + stringIndex);
+    const size_t mask = ((size_t)1 << growth->slotBits) - 1;
+    size_t slotIndex = poeGeneratorHashLast(last, growth->slotBits);
+
+    while (growth->slots[slotIndex].endingIndex != 0 && growth->slots[slotIndex].last != last)
+      slotIndex = (slotIndex + 1) & mask;
+
+    // new ending goes after existing ones, as in order of first occurrence
+    if (growth->slots[slotIndex].endingIndex == 0) {
+      PoeEnding *const ending = growth->endings + generator->endingCount;
+
+      ending->last = last;
+      ending->stringCount = 0;
+      ending->poolOffset = (uint32_t)growth->stringPoolSize;
+      growth->stringCapacities[generator->endingCount] = 0;
+      growth->slots[slotIndex].last = last;
+      growth->slots[slotIndex].endingIndex = (uint32_t)++generator->endingCount;
+    }
+
+    ok = poeGeneratorGrowthAddString(growth, growth->slots[slotIndex].endingIndex - 1, (uint32_t)stringIndex);
+    generator->stringPool = growth->stringPool;
+  }
+
+  return ok;
+} // poeGeneratorAppend function end
+
 void POE_API
 poeDestroyGenerator(
   PoeGenerator *const generator
 ) {
   assert(generator != NULL);
 
-  free(generator->stringPool);
-  free(generator->endings);
+  if (generator->growth != NULL)
+    poeGeneratorDestroyGrowth(generator->growth);
+  else if (generator->snapshot.data != NULL)
+    poeUnmapFile(&generator->snapshot);
+  else {
+    poeArenaFree(generator->arena, (void *)generator->stringPool);
+    poeArenaFree(generator->arena, (void *)generator->endings);
+  }
 } // poeGeneratorDestroy function end
 
+/// pair of distinct random indices representation structure
 struct __PoeResultOf_poeGeneratorGetRandPair {
   size_t first;
   size_t second;
 }
-poeGeneratorGetRandPair( const size_t mod ) {
+poeGeneratorGetRandPair( PoeRandom *const random, const size_t mod ) {
   assert(mod >= 2);
 
   struct __PoeResultOf_poeGeneratorGetRandPair out = {
-    .first = rand() % mod,
-    .second = rand() % mod,
+    .first = poeRandomBounded(random, (uint32_t)mod),
+    .second = poeRandomBounded(random, (uint32_t)mod - 1),
   };
 
-  while (out.second == out.first)
-    out.second = rand() % mod;
+  // second index is chosen from remaining mod - 1 ones
+  out.second += out.second >= out.first;
 
   return out;
 }
 
-char * POE_API
-poeGenerateOneginStanza( const PoeGenerator *const generator ) {
-  assert(generator != NULL);
+/**
+ * @brief ending string getting function
+ * 
+ * @param generator generator ending belongs to
+ * @param ending    ending
+ * @param index     index of string in ending
+ * 
+ * @return string
+ */
+static inline PoeString
+poeGeneratorGetEndingString( const PoeGenerator *const generator, const PoeEnding *const ending, const size_t index ) {
+  return generator->text->strings[generator->stringPool[ending->poolOffset + index]];
+} // poeGeneratorGetEndingString function end
 
+/**
+ * @brief stanza lines choosing function
+ * 
+ * @param generator generator to choose lines in
+ * @param random    random stream to choose lines by
+ * @param lines     stanza lines (output, POE_STANZA_LINE_COUNT elements)
+ * 
+ * @note generator must contain ending with at least 2 strings
+ */
+static void
+poeGeneratorChooseStanzaLines( const PoeGenerator *const generator, PoeRandom *const random, PoeString *const lines ) {
   const PoeEnding * endings[7] = {NULL};
 
   for (size_t i = 0; i < 7; i++) {
     for (;;) {
-      endings[i] = generator->endings + rand() % generator->endingCount;
+      endings[i] = generator->endings + poeRandomBounded(random, (uint32_t)generator->endingCount);
 
       if (endings[i]->stringCount < 2)
         continue;
@@ -181,61 +561,98 @@ poeGenerateOneginStanza( const PoeGenerator *const generator ) {
 
   struct __PoeResultOf_poeGeneratorGetRandPair randPair1, randPair2;
 
-  const PoeString * lines[14] = {0};
+  randPair1 = poeGeneratorGetRandPair(random, endings[0]->stringCount);
+  randPair2 = poeGeneratorGetRandPair(random, endings[1]->stringCount);
+
+  lines[ 0] = poeGeneratorGetEndingString(generator, endings[0], randPair1.first );
+  lines[ 1] = poeGeneratorGetEndingString(generator, endings[1], randPair2.first );
+  lines[ 2] = poeGeneratorGetEndingString(generator, endings[0], randPair1.second);
+  lines[ 3] = poeGeneratorGetEndingString(generator, endings[1], randPair2.second);
+
+  randPair1 = poeGeneratorGetRandPair(random, endings[2]->stringCount);
+  randPair2 = poeGeneratorGetRandPair(random, endings[3]->stringCount);
 
-  randPair1 = poeGeneratorGetRandPair(endings[0]->stringCount);
-  randPair2 = poeGeneratorGetRandPair(endings[1]->stringCount);
+  lines[ 4] = poeGeneratorGetEndingString(generator, endings[2], randPair1.first );
+  lines[ 5] = poeGeneratorGetEndingString(generator, endings[2], randPair1.second);
+  lines[ 6] = poeGeneratorGetEndingString(generator, endings[3], randPair2.first );
+  lines[ 7] = poeGeneratorGetEndingString(generator, endings[3], randPair2.second);
 
-  lines[ 0] = endings[0]->strings[randPair1.first ];
-  lines[ 1] = endings[1]->strings[randPair2.first ];
-  lines[ 2] = endings[0]->strings[randPair1.second];
-  lines[ 3] = endings[1]->strings[randPair2.second];
+  randPair1 = poeGeneratorGetRandPair(random, endings[4]->stringCount);
+  randPair2 = poeGeneratorGetRandPair(random, endings[5]->stringCount);
 
-  randPair1 = poeGeneratorGetRandPair(endings[2]->stringCount);
-  randPair2 = poeGeneratorGetRandPair(endings[3]->stringCount);
+  lines[ 8] = poeGeneratorGetEndingString(generator, endings[4], randPair1.first );
+  lines[ 9] = poeGeneratorGetEndingString(generator, endings[5], randPair2.first );
+  lines[10] = poeGeneratorGetEndingString(generator, endings[5], randPair2.second);
+  lines[11] = poeGeneratorGetEndingString(generator, endings[4], randPair1.second);
 
-  lines[ 4] = endings[2]->strings[randPair1.first ];
-  lines[ 5] = endings[2]->strings[randPair1.second];
-  lines[ 6] = endings[3]->strings[randPair2.first ];
-  lines[ 7] = endings[3]->strings[randPair2.second];
+  randPair1 = poeGeneratorGetRandPair(random, endings[6]->stringCount);
 
-  randPair1 = poeGeneratorGetRandPair(endings[4]->stringCount);
-  randPair2 = poeGeneratorGetRandPair(endings[5]->stringCount);
+  lines[12] = poeGeneratorGetEndingString(generator, endings[6], randPair1.first );
+  lines[13] = poeGeneratorGetEndingString(generator, endings[6], randPair1.second);
+} // poeGeneratorChooseStanzaLines function end
 
-  lines[ 8] = endings[4]->strings[randPair1.first ];
-  lines[ 9] = endings[5]->strings[randPair2.first ];
-  lines[10] = endings[5]->strings[randPair2.second];
-  lines[11] = endings[4]->strings[randPair1.second];
+void POE_API
+poeGenerateOneginStanza( const PoeGenerator *const generator, PoeRandom *const random, PoeString *const stanzaBuffer ) {
+  assert(generator != NULL);
+  assert(random != NULL);
+  assert(stanzaBuffer != NULL);
 
-  randPair1 = poeGeneratorGetRandPair(endings[6]->stringCount);
+  poeGeneratorChooseStanzaLines(generator, random, stanzaBuffer);
+} // poeGenerateOneginStanza function end
 
-  lines[12] = endings[6]->strings[randPair1.first ];
-  lines[13] = endings[6]->strings[randPair1.second];
+/// stanza batch generation context representation structure
+typedef struct __PoeGeneratorBatchContext {
+  const PoeGenerator * generator;    ///< generator
+  PoeString          * stanzaBuffer; ///< stanza lines buffer
+} PoeGeneratorBatchContext;
 
-  size_t totalLength = 0;
+/**
+ * @brief batch stanza generation function
+ * 
+ * @param context     batch context
+ * @param random      random stream
+ * @param stanzaIndex index of stanza to generate
+ * 
+ * @return POE_TRUE
+ */
+static PoeBool POE_API
+poeGeneratorGenerateBatchStanza( void *const context, PoeRandom *const random, const size_t stanzaIndex ) {
+  const PoeGeneratorBatchContext *const batch = (const PoeGeneratorBatchContext *)context;
 
-  for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
-    totalLength += lines[i]->end + 2 - lines[i]->begin;
+  poeGeneratorChooseStanzaLines(batch->generator, random, batch->stanzaBuffer + stanzaIndex * POE_STANZA_LINE_COUNT);
+  return POE_TRUE;
+} // poeGeneratorGenerateBatchStanza function end
 
-  char *buffer = (char *)calloc(totalLength, sizeof(char));
+PoeBool POE_API
+poeGenerateOneginStanzas(
+  const PoeGenerator *const generator,
+  const size_t stanzaCount,
+  const uint64_t seed,
+  const size_t threadCount,
+  PoeString *const stanzaBuffer
+) {
+  assert(generator != NULL);
+  assert(stanzaBuffer != NULL || stanzaCount == 0);
 
-  if (buffer == NULL)
-    return NULL;
+  if (stanzaCount == 0)
+    return POE_TRUE;
 
-  char *iter = buffer;
+  // stanza lines are chosen from endings with at least 2 strings
+  PoeBool hasRhyme = POE_FALSE;
 
-  for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
-    size_t size = lines[i]->end - lines[i]->begin;
-    memcpy(iter, lines[i]->begin, size);
-    iter += size;
+  for (size_t i = 0; !hasRhyme && i < generator->endingCount; i++)
+    hasRhyme = generator->endings[i].stringCount >= 2;
 
-    *iter++ = '\n';
-  }
+  if (!hasRhyme)
+    return POE_FALSE;
 
-  iter[-1] = '\0';
+  PoeGeneratorBatchContext batch = {
+    .generator = generator,
+    .stanzaBuffer = stanzaBuffer,
+  };
 
-  return buffer;
-} // poeGenerateOneginStanza function end
+  return poeRandomGenerateBatch(stanzaCount, seed, threadCount, poeGeneratorGenerateBatchStanza, &batch);
+} // poeGenerateOneginStanzas function end
 
 void POE_API
 poeGeneratorPrint(
@@ -248,8 +665,11 @@ poeGeneratorPrint(
   for (size_t endingIndex = 0; endingIndex < generator->endingCount; endingIndex++) {
     const PoeEnding *const ending = generator->endings + endingIndex;
 
-    for (size_t i = 0; i < ending->stringCount; i++)
-      fprintf(file, "%s\n", ending->strings[i]->begin);
+    for (size_t i = 0; i < ending->stringCount; i++) {
+      const PoeString string = poeGeneratorGetEndingString(generator, ending, i);
+
+      fprintf(file, "%.*s\n", (int)(string.end - string.begin), string.begin);
+    }
     fprintf(file, "\n----------------------------------------------------------------------\n");
   }
 } // poePrintEndings function end
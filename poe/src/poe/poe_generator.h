@@ -9,20 +9,27 @@
 
 #include "poe_core.h"
 #include "poe_compare.h"
+#include "poe_random.h"
 
 /// line end representation structure
 typedef struct __PoeEnding {
-  uint32_t     last;        ///< last characters, preprocessed and compressed in string
-  PoeString ** strings;     ///< list of indices of strings with this ending
-  size_t       stringCount; ///< count of string endings
+  uint32_t last;        ///< last characters, preprocessed and compressed in string
+  uint32_t stringCount; ///< count of strings with this ending
+  uint32_t poolOffset;  ///< offset of ending string indices in generator string pool
 } PoeEnding;
 
+/// generator ending lists growth state (created by first poeGeneratorAppend call)
+typedef struct __PoeGeneratorGrowth PoeGeneratorGrowth;
+
 /// poem generator representation structure
 typedef struct __PoeGenerator {
-  const PoeText   * text;        ///< text
-  PoeString      ** stringPool;  ///< string pool
-  PoeEnding       * endings;     ///< set of strings, qualified by ending
-  size_t            endingCount; ///< count of endings
+  const PoeText      * text;        ///< text
+  const uint32_t     * stringPool;  ///< string pool (32-bit indices of text strings, grouped by ending)
+  const PoeEnding    * endings;     ///< set of strings, qualified by ending
+  size_t               endingCount; ///< count of endings
+  PoeFileMapping       snapshot;    ///< snapshot mapping string pool and endings refer to (zeroed if generator is not loaded)
+  PoeGeneratorGrowth * growth;      ///< growth state string pool and endings belong to (NULL if generator was never appended to)
+  PoeArena           * arena;       ///< arena string pool and endings are allocated from (NULL if they are heap ones)
 } PoeGenerator;
 
 /**
@@ -30,13 +37,15 @@ typedef struct __PoeGenerator {
  * 
  * @param text      text to generate poems based on
  * @param generator generator, actually
+ * @param arena     arena to allocate generator from (NULL for heap)
  * 
  * @return POE_TRUE if initialization succeeded, POE_FALSE otherwise
  */
 PoeBool POE_API
 poeCreateGenerator(
   const PoeText *const text,
-  PoeGenerator *const generator
+  PoeGenerator *const generator,
+  PoeArena *const arena
 );
 
 /**
@@ -49,15 +58,54 @@ poeDestroyGenerator(
   PoeGenerator *const generator
 );
 
+/**
+ * @brief generator by appended text strings updating function
+ * 
+ * @param generator generator of text strings were appended to by poeAppendText
+ * @param append    append result
+ * 
+ * @note text strings must not be reordered since generator creation. Appended strings are added
+ *       to their ending lists in place, so cost is proportional to count of appended strings
+ *       (except for first call, that copies generator tables to growable heap ones); generator is the same
+ *       as if it was created for whole text, so it generates same stanzas by same seed
+ * 
+ * @return POE_TRUE if updated, POE_FALSE otherwise (generator may be destroyed only then)
+ */
+PoeBool POE_API
+poeGeneratorAppend( PoeGenerator *generator, const PoeTextAppend *append );
+
 /**
  * @brief stanza generation function
  * 
- * @param generator generator to generate stanza in
+ * @param generator    generator to generate stanza in (must contain ending with at least 2 strings)
+ * @param random       random stream to choose lines by
+ * @param stanzaBuffer buffer to write stanza lines to (POE_STANZA_LINE_COUNT elements)
  * 
- * @return generated stanza as text
+ * @note lines refer to text data, so nothing is allocated or copied; stanzas are rendered or written
+ *       by poeRenderStanzas and poeWriteStanzas
  */
-char * POE_API
-poeGenerateOneginStanza( const PoeGenerator *const generator );
+void POE_API
+poeGenerateOneginStanza( const PoeGenerator *const generator, PoeRandom *const random, PoeString *stanzaBuffer );
+
+/**
+ * @brief stanza batch generation function
+ * 
+ * @param generator    generator to generate stanzas in
+ * @param stanzaCount  count of stanzas to generate
+ * @param seed         random seed (same seed gives same stanzas regardless of thread count)
+ * @param threadCount  count of threads to generate on (0 for hardware thread count)
+ * @param stanzaBuffer buffer to write stanza lines to (stanzaCount * POE_STANZA_LINE_COUNT elements)
+ * 
+ * @return POE_TRUE if generated, POE_FALSE if text has no rhymes
+ */
+PoeBool POE_API
+poeGenerateOneginStanzas(
+  const PoeGenerator *const generator,
+  size_t stanzaCount,
+  uint64_t seed,
+  size_t threadCount,
+  PoeString *stanzaBuffer
+);
 
 /**
  * @brief endings display function
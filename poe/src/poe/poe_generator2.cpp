@@ -5,6 +5,7 @@
  */
 
 #include "poe_generator2.h"
+#include "poe_arena.h"
 
 /**
  * @brief last characters getting function
@@ -17,121 +18,240 @@ static uint32_t
 poeGeneratorGetStringLastCharacters( const PoeString *const string ) {
   assert(string != NULL);
 
-  char buffer[4] = {0};
+  const unsigned char *const weights = poeCompareCurrentCollation->weights;
+  unsigned char buffer[4] = {0};
   size_t bufferSize = 0;
-  unsigned char *iter = (unsigned char *)string->end - 1;
+  const unsigned char *iter = (const unsigned char *)string->end;
+  const unsigned char *const begin = (const unsigned char *)string->begin;
 
-  while (bufferSize < 3 && *iter != '\0') {
-    if (poeCompareCheckCharacterComparability(*iter))
-      buffer[bufferSize++] = poeCompareProcessCharacter(*iter);
-    iter--;
+  // skipped characters have zero weight, so they are overwritten by next comparable one
+  while (bufferSize < 3 && iter > begin) {
+    const unsigned char weight = weights[*--iter];
+
+    buffer[bufferSize] = weight;
+    bufferSize += weight != 0;
   }
 
   return *(uint32_t *)buffer;
 } // poeGeneratorGetStringLastCharacters function end
 
+/**
+ * @brief rhyme class index building function
+ * 
+ * @param generator generator with rhyme-sorted strings
+ * 
+ * @note strings with same ending code go one after another in rhyme order, so every class
+ *       is single run found in one pass. Strings of classes of at least 2 strings are listed
+ *       separately, so base lines are drawn without skipping strings that have no rhyme
+ * 
+ * @return POE_TRUE if built, POE_FALSE if allocation failed
+ */
+static PoeBool
+poeGenerator2BuildRhymes( PoeGenerator2 *const generator ) {
+  const PoeString *const strings = generator->strings;
+  const size_t stringCount = generator->text->stringCount;
+
+  PoeGenerator2Rhyme *const rhymes = (PoeGenerator2Rhyme *)poeArenaAllocate(generator->arena, stringCount * sizeof(PoeGenerator2Rhyme));
+
+  if (rhymes == NULL && stringCount != 0)
+    return POE_FALSE;
+
+  generator->rhymes = rhymes;
+
+  for (size_t i = 0; i < stringCount; i++)
+    rhymes[i].last = poeGeneratorGetStringLastCharacters(strings + i);
+
+  size_t classBegin = 0;
+  size_t rhymedStringCount = 0;
+
+  for (size_t i = 1; i <= stringCount; i++) {
+    const PoeBool isClassEnd =
+      i == stringCount ||
+      rhymes[i].last != rhymes[classBegin].last ||
+      strings[i].begin == strings[i].end ||
+      strings[classBegin].begin == strings[classBegin].end;
+
+    if (!isClassEnd)
+      continue;
+
+    for (size_t k = classBegin; k < i; k++) {
+      rhymes[k].classBegin = (uint32_t)classBegin;
+      rhymes[k].classSize = (uint32_t)(i - classBegin);
+    }
+
+    rhymedStringCount += i - classBegin >= 2 ? i - classBegin : 0;
+    classBegin = i;
+  }
+
+  if (rhymedStringCount == 0)
+    return POE_TRUE;
+
+  uint32_t *const rhymedStrings = (uint32_t *)poeArenaAllocate(generator->arena, rhymedStringCount * sizeof(uint32_t));
+
+  if (rhymedStrings == NULL)
+    return POE_FALSE;
+
+  uint32_t *rhymedIter = rhymedStrings;
+
+  for (size_t i = 0; i < stringCount; i++)
+    if (rhymes[i].classSize >= 2)
+      *rhymedIter++ = (uint32_t)i;
+
+  generator->rhymedStrings = rhymedStrings;
+  generator->rhymedStringCount = rhymedStringCount;
+
+  return POE_TRUE;
+} // poeGenerator2BuildRhymes function end
+
 /**
  * @brief generator constructor
  * 
  * @param text      text to generate poems based on
  * @param generator generator, actually
+ * @param arena     arena to allocate generator from (NULL for heap)
  * 
  * @return POE_TRUE if initialization succeeded, POE_FALSE otherwise
  */
 PoeBool POE_API
 poeCreateGenerator2(
   const PoeText *const text,
-  PoeGenerator2 *const generator
+  PoeGenerator2 *const generator,
+  PoeArena *const arena
 ) {
   assert(text != NULL);
   assert(generator != NULL);
 
-  PoeString *strings = (PoeString *)calloc(text->stringCount, sizeof(PoeString));
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
+  memset(generator, 0, sizeof(PoeGenerator2));
+
+  // class boundaries are 32-bit
+  if (text->stringCount >= UINT32_MAX)
+    return POE_FALSE;
+
+  PoeString *strings = (PoeString *)poeArenaAllocate(arena, text->stringCount * sizeof(PoeString));
 
   if (strings == NULL)
     return POE_FALSE;
 
   memcpy(strings, text->strings, text->stringCount * sizeof(PoeString));
-  /// sort strings
-  qsort_s(strings, text->stringCount, sizeof(PoeString), poeStdCompareWrapper, poeCompareFromEnd);
+
+  /// sort strings in rhyme order
+  PoeText rhymeText = {0};
+  rhymeText.strings = strings;
+  rhymeText.stringCount = text->stringCount;
+
+  if (!POE_CHECK(poeSortTextRhyme(&rhymeText))) {
+    poeArenaFree(arena, strings);
+    return POE_FALSE;
+  }
 
   generator->text = text;
+  generator->arena = arena;
   generator->strings = strings;
 
+  if (!poeGenerator2BuildRhymes(generator)) {
+    poeDestroyGenerator2(generator);
+    return POE_FALSE;
+  }
+
   return POE_TRUE;
 } // poeCreateGenerator2 function end
 
 PoeBool POE_API
-poeGenerateOneginStanza2( const PoeGenerator2 *const generator, const PoeString **stanzaBuffer ) {
+poeGenerateOneginStanza2( const PoeGenerator2 *const generator, PoeRandom *const random, PoeString *const stanzaBuffer ) {
   assert(generator != NULL);
+  assert(random != NULL);
 
-  size_t baseIndices[7] = { 0 };
-
-  for (size_t i = 0; i < 7; i++) {
-    const PoeString *str = generator->strings + baseIndices[i];
-
-    // trying to ignore empty strings
-    do {
-      baseIndices[i] = rand() % (generator->text->stringCount - 30) + 15;
-      str = generator->strings + baseIndices[i];
-    } while (str->begin == str->end);
-  }
+  if (generator->rhymedStringCount == 0)
+    return POE_FALSE;
 
   const PoeString *lines[14] = {NULL};
 
   for (size_t baseIndexIter = 0; baseIndexIter < 7; baseIndexIter++) {
-    size_t baseIndex = baseIndices[baseIndexIter];
-
-    const PoeString *first = generator->strings + baseIndex;
-    const PoeString *second = NULL;
-
-    uint32_t firstLastChars = poeGeneratorGetStringLastCharacters(generator->strings + baseIndex);
+    // base line is drawn among strings that have rhyme (empty ones never do), so partner always exists
+    const uint32_t baseIndex = generator->rhymedStrings[poeRandomBounded(random, (uint32_t)generator->rhymedStringCount)];
+    const PoeGenerator2Rhyme *const rhyme = generator->rhymes + baseIndex;
 
-    size_t i = 0;
-    for (i = 14; i > 0; i--)
-      if (poeGeneratorGetStringLastCharacters(generator->strings + baseIndex + i) == firstLastChars) {
-        second = generator->strings + baseIndex + i;
-        break;
-      } else if (poeGeneratorGetStringLastCharacters(generator->strings + baseIndex - i) == firstLastChars) {
-        second = generator->strings + baseIndex - i;
-        break;
-      }
+    // partner is chosen from remaining classSize - 1 strings of class
+    uint32_t partnerIndex = rhyme->classBegin + poeRandomBounded(random, rhyme->classSize - 1);
+    partnerIndex += partnerIndex >= baseIndex;
 
-    if (second == NULL)
-      return POE_FALSE;
-
-    lines[baseIndexIter * 2 + 0] = first;
-    lines[baseIndexIter * 2 + 1] = second;
+    lines[baseIndexIter * 2 + 0] = generator->strings + baseIndex;
+    lines[baseIndexIter * 2 + 1] = generator->strings + partnerIndex;
   }
 
-  stanzaBuffer[ 0] = lines[ 0];
-  stanzaBuffer[ 1] = lines[ 2];
-  stanzaBuffer[ 2] = lines[ 1];
-  stanzaBuffer[ 3] = lines[ 3];
+  stanzaBuffer[ 0] = *lines[ 0];
+  stanzaBuffer[ 1] = *lines[ 2];
+  stanzaBuffer[ 2] = *lines[ 1];
+  stanzaBuffer[ 3] = *lines[ 3];
 
-  stanzaBuffer[ 4] = lines[ 4];
-  stanzaBuffer[ 5] = lines[ 5];
-  stanzaBuffer[ 6] = lines[ 6];
-  stanzaBuffer[ 7] = lines[ 7];
+  stanzaBuffer[ 4] = *lines[ 4];
+  stanzaBuffer[ 5] = *lines[ 5];
+  stanzaBuffer[ 6] = *lines[ 6];
+  stanzaBuffer[ 7] = *lines[ 7];
 
-  stanzaBuffer[ 8] = lines[ 8];
-  stanzaBuffer[ 9] = lines[10];
-  stanzaBuffer[10] = lines[11];
-  stanzaBuffer[11] = lines[ 9];
+  stanzaBuffer[ 8] = *lines[ 8];
+  stanzaBuffer[ 9] = *lines[10];
+  stanzaBuffer[10] = *lines[11];
+  stanzaBuffer[11] = *lines[ 9];
 
-  stanzaBuffer[12] = lines[12];
-  stanzaBuffer[13] = lines[13];
+  stanzaBuffer[12] = *lines[12];
+  stanzaBuffer[13] = *lines[13];
 
   return POE_TRUE;
 } // poeGenerateOneginStanza2 function end
 
+/// stanza batch generation context representation structure
+typedef struct __PoeGenerator2BatchContext {
+  const PoeGenerator2 * generator;    ///< generator
+  PoeString           * stanzaBuffer; ///< stanza lines buffer
+} PoeGenerator2BatchContext;
+
+/**
+ * @brief batch stanza generation function
+ * 
+ * @param context     batch context
+ * @param random      random stream
+ * @param stanzaIndex index of stanza to generate
+ * 
+ * @return POE_TRUE if generated, POE_FALSE if text has no rhymes
+ */
+static PoeBool POE_API
+poeGenerator2GenerateBatchStanza( void *const context, PoeRandom *const random, const size_t stanzaIndex ) {
+  const PoeGenerator2BatchContext *const batch = (const PoeGenerator2BatchContext *)context;
+
+  return poeGenerateOneginStanza2(batch->generator, random, batch->stanzaBuffer + stanzaIndex * POE_STANZA_LINE_COUNT);
+} // poeGenerator2GenerateBatchStanza function end
+
+PoeBool POE_API
+poeGenerateOneginStanzas2(
+  const PoeGenerator2 *const generator,
+  const size_t stanzaCount,
+  const uint64_t seed,
+  const size_t threadCount,
+  PoeString *const stanzaBuffer
+) {
+  assert(generator != NULL);
+  assert(stanzaBuffer != NULL || stanzaCount == 0);
+
+  PoeGenerator2BatchContext batch = {
+    .generator = generator,
+    .stanzaBuffer = stanzaBuffer,
+  };
+
+  return poeRandomGenerateBatch(stanzaCount, seed, threadCount, poeGenerator2GenerateBatchStanza, &batch);
+} // poeGenerateOneginStanzas2 function end
+
 void POE_API
 poeDestroyGenerator2(
   PoeGenerator2 *const generator
 ) {
   assert(generator != NULL);
 
-  free(generator->strings);
+  poeArenaFree(generator->arena, generator->strings);
+  poeArenaFree(generator->arena, generator->rhymes);
+  poeArenaFree(generator->arena, generator->rhymedStrings);
 } // poeCreateGenerator function end
 
 // poe_generator2.cpp file end
@@ -8,11 +8,24 @@
 #define POE_GENERATOR2_H_
 
 #include "poe_sort.h"
+#include "poe_radix.h"
+#include "poe_random.h"
+
+/// rhyme class index entry of rhyme-sorted string
+typedef struct __PoeGenerator2Rhyme {
+  uint32_t last;       ///< ending code (last characters of string)
+  uint32_t classBegin; ///< index of first string of rhyme class (run of rhyme-sorted strings with same ending code)
+  uint32_t classSize;  ///< count of strings in rhyme class (empty strings never rhyme, so they are classes of 1 string)
+} PoeGenerator2Rhyme;
 
 /// Second-generation text generator
 typedef struct __PoeGenerator2 {
-  const PoeText *text; ///< Text
-  PoeString *strings;  ///< Own strings
+  const PoeText      * text;              ///< Text
+  PoeString          * strings;           ///< Own strings (in rhyme order)
+  PoeGenerator2Rhyme * rhymes;            ///< rhyme class of every own string
+  uint32_t           * rhymedStrings;     ///< indices of own strings in classes of at least 2 strings (base line candidates)
+  size_t               rhymedStringCount; ///< count of strings in classes of at least 2 strings
+  PoeArena           * arena;             ///< arena strings, rhymes and rhymed strings are allocated from (NULL if they are heap ones)
 } PoeGenerator2;
 
 /**
@@ -20,25 +33,50 @@ typedef struct __PoeGenerator2 {
  * 
  * @param text      text to generate poems based on
  * @param generator generator, actually
+ * @param arena     arena to allocate generator from (NULL for heap)
  * 
  * @return POE_TRUE if initialization succeeded, POE_FALSE otherwise
  */
 PoeBool POE_API
 poeCreateGenerator2(
   const PoeText *const text,
-  PoeGenerator2 *const generator
+  PoeGenerator2 *const generator,
+  PoeArena *const arena
 );
 
 /**
  * @brief stanza generation function
  * 
  * @param generator    generator to generate stanza in
+ * @param random       random stream to choose lines by
  * @param stanzaBuffer buffer to write stanza lines in
  * 
- * @return true if generated, false otherwise
+ * @note base lines are drawn among strings that have rhyme, partners are drawn in their rhyme classes
+ * 
+ * @return true if generated, false if text has no rhymes
+ */
+PoeBool POE_API
+poeGenerateOneginStanza2( const PoeGenerator2 *const generator, PoeRandom *const random, PoeString *stanzaBuffer );
+
+/**
+ * @brief stanza batch generation function
+ * 
+ * @param generator    generator to generate stanzas in
+ * @param stanzaCount  count of stanzas to generate
+ * @param seed         random seed (same seed gives same stanzas regardless of thread count)
+ * @param threadCount  count of threads to generate on (0 for hardware thread count)
+ * @param stanzaBuffer buffer to write stanza lines to (stanzaCount * POE_STANZA_LINE_COUNT elements)
+ * 
+ * @return POE_TRUE if all stanzas are generated, POE_FALSE if text has no rhymes
  */
 PoeBool POE_API
-poeGenerateOneginStanza2( const PoeGenerator2 *const generator, const PoeString **stanzaBuffer );
+poeGenerateOneginStanzas2(
+  const PoeGenerator2 *const generator,
+  size_t stanzaCount,
+  uint64_t seed,
+  size_t threadCount,
+  PoeString *stanzaBuffer
+);
 
 /**
  * @brief string generator initialization function
@@ -0,0 +1,202 @@
+/**
+ * @file   poe/poe_key.cpp
+ * @author tiot2
+ * @brief  Poem processor normalized sort key implementation module
+ */
+
+#include "poe.h"
+
+PoeStatus POE_API
+poeCreateTextKeys( const PoeText *const text, PoeTextKeys *const keys ) {
+  assert(text != NULL);
+  assert(keys != NULL);
+
+  memset(keys, 0, sizeof(PoeTextKeys));
+
+  size_t keyBufferSize = 0;
+
+  for (size_t i = 0; i < text->stringCount; i++)
+    for (const char *iter = text->strings[i].begin; iter < text->strings[i].end; iter++)
+      keyBufferSize += poeCompareCheckCharacterComparability((unsigned char)*iter) != POE_FALSE;
+
+  // forward and reversed keys, at least one byte to allocate
+  unsigned char *keyBuffer = (unsigned char *)poeArenaAllocate(NULL, keyBufferSize * 2 + 1);
+  PoeSortKey *forwardKeys = (PoeSortKey *)poeArenaAllocateZeroed(NULL, text->stringCount + 1, sizeof(PoeSortKey));
+  PoeSortKey *reverseKeys = (PoeSortKey *)poeArenaAllocateZeroed(NULL, text->stringCount + 1, sizeof(PoeSortKey));
+
+  if (keyBuffer == NULL || forwardKeys == NULL || reverseKeys == NULL) {
+    free(keyBuffer);
+    free(forwardKeys);
+    free(reverseKeys);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  unsigned char *forwardIter = keyBuffer;
+  unsigned char *reverseIter = keyBuffer + keyBufferSize;
+
+  for (size_t i = 0; i < text->stringCount; i++) {
+    const PoeString *const string = text->strings + i;
+    unsigned char *const forwardBegin = forwardIter;
+
+    for (const char *iter = string->begin; iter < string->end; iter++)
+      if (poeCompareCheckCharacterComparability((unsigned char)*iter))
+        *forwardIter++ = poeCompareProcessCharacter((unsigned char)*iter);
+
+    const size_t size = forwardIter - forwardBegin;
+
+    for (size_t k = 0; k < size; k++)
+      reverseIter[k] = forwardBegin[size - 1 - k];
+
+    forwardKeys[i].begin = forwardBegin;
+    forwardKeys[i].size = size;
+    reverseKeys[i].begin = reverseIter;
+    reverseKeys[i].size = size;
+
+    reverseIter += size;
+  }
+
+  keys->keyBuffer = keyBuffer;
+  keys->forwardKeys = forwardKeys;
+  keys->reverseKeys = reverseKeys;
+  keys->keyCount = text->stringCount;
+
+  return POE_STATUS_OK;
+} // poeCreateTextKeys function end
+
+void POE_API
+poeDestroyTextKeys( PoeTextKeys *const keys ) {
+  assert(keys != NULL);
+
+  free(keys->keyBuffer);
+  free(keys->forwardKeys);
+  free(keys->reverseKeys);
+} // poeDestroyTextKeys function end
+
+uint64_t POE_API
+poeGetKeyPrefix( const PoeString *const string, const PoeKeyOrder order ) {
+  assert(string != NULL);
+
+  const unsigned char *const weights = poeCompareCurrentCollation->weights;
+  uint64_t prefix = 0;
+  unsigned int size = 0;
+
+  if (order == POE_KEY_ORDER_FORWARD) {
+    for (const char *iter = string->begin; size < 8 && iter < string->end; iter++) {
+      const unsigned char weight = weights[(unsigned char)*iter];
+
+      if (weight != 0) {
+        prefix = prefix << 8 | weight;
+        size++;
+      }
+    }
+  } else {
+    for (const char *iter = string->end; size < 8 && iter > string->begin; ) {
+      const unsigned char weight = weights[(unsigned char)*--iter];
+
+      if (weight != 0) {
+        prefix = prefix << 8 | weight;
+        size++;
+      }
+    }
+  }
+
+  return size == 0 ? 0 : prefix << (8 - size) * 8;
+} // poeGetKeyPrefix function end
+
+PoeKeyedRecord * POE_API
+poeCreateKeyedRecords( const PoeTextKeys *const keys, const PoeKeyOrder order ) {
+  assert(keys != NULL);
+
+  PoeKeyedRecord *records = (PoeKeyedRecord *)poeArenaAllocateZeroed(NULL, keys->keyCount + 1, sizeof(PoeKeyedRecord));
+
+  if (records == NULL)
+    return NULL;
+
+  const PoeSortKey *const orderKeys = order == POE_KEY_ORDER_FORWARD ? keys->forwardKeys : keys->reverseKeys;
+
+  for (size_t i = 0; i < keys->keyCount; i++) {
+    records[i].key = orderKeys[i];
+    records[i].index = i;
+  }
+
+  return records;
+} // poeCreateKeyedRecords function end
+
+PoeStatus POE_API
+poeApplyKeyedRecords( PoeText *const text, PoeTextKeys *const keys, const PoeKeyedRecord *const records ) {
+  assert(text != NULL);
+  assert(keys != NULL);
+  assert(records != NULL);
+  assert(keys->keyCount == text->stringCount);
+
+  const size_t count = text->stringCount;
+
+  PoeString *strings = (PoeString *)poeArenaAllocateZeroed(NULL, count + 1, sizeof(PoeString));
+  PoeSortKey *forwardKeys = (PoeSortKey *)poeArenaAllocateZeroed(NULL, count + 1, sizeof(PoeSortKey));
+  PoeSortKey *reverseKeys = (PoeSortKey *)poeArenaAllocateZeroed(NULL, count + 1, sizeof(PoeSortKey));
+
+  if (strings == NULL || forwardKeys == NULL || reverseKeys == NULL) {
+    free(strings);
+    free(forwardKeys);
+    free(reverseKeys);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    strings[i] = text->strings[records[i].index];
+    forwardKeys[i] = keys->forwardKeys[records[i].index];
+    reverseKeys[i] = keys->reverseKeys[records[i].index];
+  }
+
+  memcpy(text->strings, strings, count * sizeof(PoeString));
+  free(strings);
+
+  free(keys->forwardKeys);
+  free(keys->reverseKeys);
+  keys->forwardKeys = forwardKeys;
+  keys->reverseKeys = reverseKeys;
+
+  return POE_STATUS_OK;
+} // poeApplyKeyedRecords function end
+
+/// keyed records compare functor
+struct PoeKeyedRecordComparator {
+  /**
+   * @brief compare operator
+   * 
+   * @param lhs left hand side
+   * @param rhs right hand side
+   * 
+   * @return ordering
+   */
+  inline PoeOrdering
+  operator()( const PoeKeyedRecord *const lhs, const PoeKeyedRecord *const rhs ) const {
+    return poeCompareKeys(&lhs->key, &rhs->key);
+  } // operator() end
+}; // struct PoeKeyedRecordComparator end
+
+PoeStatus POE_API
+poeSortTextKeyed( PoeText *const text, PoeTextKeys *const keys, const PoeKeyOrder order ) {
+  assert(text != NULL);
+  assert(keys != NULL);
+  assert(keys->keyCount == text->stringCount);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  if (text->stringCount < 2)
+    return POE_STATUS_OK;
+
+  PoeKeyedRecord *records = poeCreateKeyedRecords(keys, order);
+
+  if (records == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  poeTextHybridSort(records, records + text->stringCount, PoeKeyedRecordComparator(), POE_TRUE);
+
+  PoeStatus status = poeApplyKeyedRecords(text, keys, records);
+  free(records);
+
+  return status;
+} // poeSortTextKeyed function end
+
+// poe_key.cpp file end
@@ -0,0 +1,131 @@
+/**
+ * @file   poe/poe_key.h
+ * @author tiot2
+ * @brief  Poem processor normalized sort key declaration module
+ */
+
+#ifndef POE_KEY_H_
+#define POE_KEY_H_
+
+#include "poe_compare.h"
+
+/// normalized string sort key representation structure
+typedef struct __PoeSortKey {
+  const unsigned char * begin; ///< key first byte
+  size_t                size;  ///< key size
+} PoeSortKey;
+
+/// key order
+typedef enum __PoeKeyOrder {
+  POE_KEY_ORDER_FORWARD = 0, ///< poeCompareFromStart order
+  POE_KEY_ORDER_REVERSE = 1, ///< poeCompareFromEnd order
+} PoeKeyOrder;
+
+/// text normalized sort keys representation structure
+typedef struct __PoeTextKeys {
+  unsigned char * keyBuffer;   ///< forward and reversed keys bulk allocation
+  PoeSortKey    * forwardKeys; ///< forward keys (parallel to text strings)
+  PoeSortKey    * reverseKeys; ///< reversed keys (parallel to text strings)
+  size_t          keyCount;    ///< count of keys (equal to count of text strings)
+} PoeTextKeys;
+
+/**
+ * @brief text sort keys constructor
+ * 
+ * @param text text to build keys of
+ * @param keys keys to build
+ * 
+ * @note key is string characters filtered by poeCompareCheckCharacterComparability and
+ *       processed by poeCompareProcessCharacter, so memcmp-based key comparison gives the
+ *       same ordering as poeCompareFromStart (and poeCompareFromEnd for reversed keys) does
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeCreateTextKeys( const PoeText *text, PoeTextKeys *keys );
+
+/**
+ * @brief text sort keys destructor
+ * 
+ * @param keys keys to destroy
+ */
+void POE_API
+poeDestroyTextKeys( PoeTextKeys *keys );
+
+/**
+ * @brief sort keys comparing function
+ * 
+ * @param lhs left hand side
+ * @param rhs right hand side
+ * 
+ * @return ordering
+ */
+inline PoeOrdering POE_API
+poeCompareKeys( const PoeSortKey *const lhs, const PoeSortKey *const rhs ) {
+  const int result = memcmp(lhs->begin, rhs->begin, lhs->size < rhs->size ? lhs->size : rhs->size);
+
+  return result < 0
+    ? POE_ORDERING_LESS
+    : result > 0
+      ? POE_ORDERING_MORE
+      : poeCompareSize(lhs->size, rhs->size);
+} // poeCompareKeys function end
+
+/**
+ * @brief key prefix getting function
+ * 
+ * @param string string to get key prefix of
+ * @param order  key order
+ * 
+ * @return first 8 key characters (first character in most significant byte, zero-padded if key is shorter),
+ *         so prefix comparison gives the same ordering as key comparison for keys shorter than 8 characters
+ */
+uint64_t POE_API
+poeGetKeyPrefix( const PoeString *string, PoeKeyOrder order );
+
+/// keyed sort record representation structure
+typedef struct __PoeKeyedRecord {
+  PoeSortKey key;   ///< string key
+  size_t     index; ///< string index before sort
+} PoeKeyedRecord;
+
+/**
+ * @brief keyed sort records constructor
+ * 
+ * @param keys  text keys
+ * @param order order to take keys for
+ * 
+ * @return record array (i-th record refers to i-th string), NULL if allocation failed; must be freed by free
+ */
+PoeKeyedRecord * POE_API
+poeCreateKeyedRecords( const PoeTextKeys *keys, PoeKeyOrder order );
+
+/**
+ * @brief sorted records to text and keys applying function
+ * 
+ * @param text    text records were built for
+ * @param keys    keys records were built from
+ * @param records sorted records
+ * 
+ * @return operation status (text and keys are not changed in case of failure)
+ */
+PoeStatus POE_API
+poeApplyKeyedRecords( PoeText *text, PoeTextKeys *keys, const PoeKeyedRecord *records );
+
+/**
+ * @brief text by precomputed keys sorting function
+ * 
+ * @param text  text to sort
+ * @param keys  keys of text (permuted with text strings, so they stay parallel to them)
+ * @param order sort order
+ * 
+ * @note records are sorted by poeSortText algorithm with key comparison
+ * 
+ * @return operation status (text and keys are not changed in case of failure)
+ */
+PoeStatus POE_API
+poeSortTextKeyed( PoeText *text, PoeTextKeys *keys, PoeKeyOrder order );
+
+#endif // !defined(POE_KEY_H_)
+
+// poe_key.h file end
@@ -0,0 +1,127 @@
+/**
+ * @file   poe/poe_mapping.cpp
+ * @author tiot2
+ * @brief  Poem processor file mapping implementation module
+ */
+
+#include "poe_core.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+PoeBool POE_API
+poeMapFile( const char *const fileName, PoeFileMapping *const dst ) {
+  assert(fileName != NULL);
+  assert(dst != NULL);
+
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+  if (file == INVALID_HANDLE_VALUE)
+    return POE_FALSE;
+
+  LARGE_INTEGER fileSize = {0};
+
+  if (!GetFileSizeEx(file, &fileSize)) {
+    CloseHandle(file);
+    return POE_FALSE;
+  }
+
+  // zero-sized files can't be mapped
+  if (fileSize.QuadPart == 0) {
+    CloseHandle(file);
+    dst->data = NULL;
+    dst->size = 0;
+    return POE_TRUE;
+  }
+
+  HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+
+  if (fileMapping == NULL)
+    return POE_FALSE;
+
+  // view keeps mapping object alive, so handle may be closed right after mapping
+  const void *view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(fileMapping);
+
+  if (view == NULL)
+    return POE_FALSE;
+
+  dst->data = (const char *)view;
+  dst->size = (size_t)fileSize.QuadPart;
+
+  return POE_TRUE;
+} // poeMapFile function end
+
+void POE_API
+poeUnmapFile( PoeFileMapping *const mapping ) {
+  assert(mapping != NULL);
+
+  if (mapping->data != NULL)
+    UnmapViewOfFile(mapping->data);
+
+  mapping->data = NULL;
+  mapping->size = 0;
+} // poeUnmapFile function end
+
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+PoeBool POE_API
+poeMapFile( const char *const fileName, PoeFileMapping *const dst ) {
+  assert(fileName != NULL);
+  assert(dst != NULL);
+
+  int file = open(fileName, O_RDONLY);
+
+  if (file == -1)
+    return POE_FALSE;
+
+  struct stat fileStat;
+
+  if (fstat(file, &fileStat) == -1) {
+    close(file);
+    return POE_FALSE;
+  }
+
+  // zero-sized files can't be mapped
+  if (fileStat.st_size == 0) {
+    close(file);
+    dst->data = NULL;
+    dst->size = 0;
+    return POE_TRUE;
+  }
+
+  void *view = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+
+  if (view == MAP_FAILED)
+    return POE_FALSE;
+
+  madvise(view, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+  dst->data = (const char *)view;
+  dst->size = (size_t)fileStat.st_size;
+
+  return POE_TRUE;
+} // poeMapFile function end
+
+void POE_API
+poeUnmapFile( PoeFileMapping *const mapping ) {
+  assert(mapping != NULL);
+
+  if (mapping->data != NULL)
+    munmap((void *)mapping->data, mapping->size);
+
+  mapping->data = NULL;
+  mapping->size = 0;
+} // poeUnmapFile function end
+
+#endif // defined(_WIN32)
+
+// poe_mapping.cpp file end
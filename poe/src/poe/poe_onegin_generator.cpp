@@ -5,27 +5,49 @@
  */
 
 #include "poe_onegin_generator.h"
+#include "poe_arena.h"
+#include "poe_array.h"
 
-PoeOneginGeneratorStatus POE_API
-poeCreateOneginGenerator(
-  const PoeText *const text,
-  PoeOneginGenerator *const generator
-) {
-  assert(text != NULL);
-  assert(generator != NULL);
+/**
+ * @brief line emptiness checking function
+ *
+ * @param lines text strings in initial order
+ * @param index line index
+ *
+ * @return POE_TRUE if line is empty, POE_FALSE otherwise
+ */
+static inline PoeBool
+poeOneginIsLineEmpty( const PoeCompactText *const lines, const size_t index ) {
+  const PoeString string = poeCompactGetString(lines, (uint32_t)index);
 
-  const PoeString **stanzaStartLines = (const PoeString **)darrCreate(sizeof(PoeString *), 0);
+  return string.begin == string.end;
+} // poeOneginIsLineEmpty function end
 
-  for (size_t stringIndex = 0; stringIndex < text->stringCount - 15; stringIndex++) {
-    const PoeString *current = text->strings + stringIndex;
+/**
+ * @brief stanzas adding function
+ *
+ * @param generator generator to add stanzas to (lines must be set)
+ * @param firstLine index of first line generator stanzas were not detected in (0 for empty generator)
+ *
+ * @note stanza is 14 non-empty lines after empty one, followed by any line and empty one,
+ *       so only stanzas that end at firstLine or after it are detected
+ *
+ * @return status
+ */
+static PoeOneginGeneratorStatus
+poeOneginAddStanzas( PoeOneginGenerator *const generator, const size_t firstLine ) {
+  const PoeCompactText *const lines = &generator->lines;
+  // appends usually add few stanzas, so they are detected without heap allocation
+  PoeArray<uint32_t, 64> stanzaStartLines;
 
-    if (current->begin != current->end) {
+  // stanzas with last (16th) line before firstLine were detected before
+  for (size_t lineIndex = firstLine < 16 ? 0 : firstLine - 16; lineIndex + 16 < lines->stringCount; lineIndex++) {
+    if (!poeOneginIsLineEmpty(lines, lineIndex))
       continue;
-    }
 
     PoeBool isStanza = POE_TRUE;
     for (size_t i = 1; i < 15; i++) {
-      if (current[i].begin == current[i].end) {
+      if (poeOneginIsLineEmpty(lines, lineIndex + i)) {
         isStanza = POE_FALSE;
         break;
       }
@@ -35,22 +57,48 @@ poeCreateOneginGenerator(
       continue;
 
     // check for line is empty or not
-    if (current[16].begin != current[16].end)
+    if (!poeOneginIsLineEmpty(lines, lineIndex + 16))
       continue;
 
-    current++;
-    if ((stanzaStartLines = (const PoeString **)darrPush(stanzaStartLines, &current)) == NULL)
+    const uint32_t stanzaStart = (uint32_t)lineIndex + 1;
+    if (!stanzaStartLines.push(stanzaStart))
       return POE_ONEGIN_GENERATOR_STATUS_BAD_ALLOC;
   }
 
-  size_t stanzaCount = darrGetSize(stanzaStartLines);
+  const size_t stanzaCount = stanzaStartLines.count;
+  const size_t oldBucketSize = generator->buckets[0].stringPairCount;
+  const size_t bucketSize = oldBucketSize + stanzaCount;
+
+  // buckets grow geometrically, so every pair is moved O(1) times on average
+  if (bucketSize > generator->stringPairCapacity) {
+    size_t capacity = generator->stringPairCapacity * 2;
+
+    if (capacity < bucketSize)
+      capacity = bucketSize;
+
+    PoeOneginStringPair *stringPairBuffer = (PoeOneginStringPair *)poeArenaAllocateZeroed(
+      generator->arena,
+      capacity * POE_ONEGIN_BUCKET_COUNT + 1,
+      sizeof(PoeOneginStringPair)
+    );
+
+    if (stringPairBuffer == NULL)
+      return POE_ONEGIN_GENERATOR_STATUS_BAD_ALLOC;
+
+    for (size_t i = 0; i < POE_ONEGIN_BUCKET_COUNT; i++) {
+      if (oldBucketSize != 0)
+        memcpy(stringPairBuffer + capacity * i, generator->buckets[i].stringPairSet, oldBucketSize * sizeof(PoeOneginStringPair));
+      generator->buckets[i].stringPairSet = stringPairBuffer + capacity * i;
+    }
 
-  size_t stringPairCount = stanzaCount * POE_ONEGIN_BUCKET_COUNT;
-  PoeOneginStringPair *stringPairBuffer = (PoeOneginStringPair *)calloc(stringPairCount, sizeof(PoeOneginStringPair));
+    // loaded pairs are copied, so snapshot is not needed anymore
+    if (generator->snapshot.data != NULL)
+      poeUnmapFile(&generator->snapshot);
+    memset(&generator->snapshot, 0, sizeof(PoeFileMapping));
 
-  for (size_t i = 0; i < POE_ONEGIN_BUCKET_COUNT; i++) {
-    generator->buckets[i].stringPairSet = stringPairBuffer + stanzaCount * i;
-    generator->buckets[i].stringPairCount = 0;
+    poeArenaFree(generator->arena, generator->stringPairBuffer);
+    generator->stringPairBuffer = stringPairBuffer;
+    generator->stringPairCapacity = capacity;
   }
 
   struct {
@@ -64,68 +112,178 @@ poeCreateOneginGenerator(
   };
 
   for (size_t i = 0; i < stanzaCount; i++) {
-    const PoeString *stanzaStart = stanzaStartLines[i];
+    const uint32_t stanzaStart = stanzaStartLines[i];
 
     for (size_t bucketIndex = 0; bucketIndex < POE_ONEGIN_BUCKET_COUNT; bucketIndex++) {
-      PoeOneginBucket *bucket = generator->buckets + bucketIndex;
-
-      bucket->stringPairSet[bucket->stringPairCount].first  = stanzaStart[stringBucketIndices[bucketIndex].first ];
-      bucket->stringPairSet[bucket->stringPairCount].second = stanzaStart[stringBucketIndices[bucketIndex].second];
+      PoeOneginStringPair *pair = generator->stringPairBuffer + generator->stringPairCapacity * bucketIndex + oldBucketSize + i;
 
-      bucket->stringPairCount++;
+      pair->first  = stanzaStart + (uint32_t)stringBucketIndices[bucketIndex].first;
+      pair->second = stanzaStart + (uint32_t)stringBucketIndices[bucketIndex].second;
     }
   }
 
-  darrDestroy(stanzaStartLines);
+  for (size_t i = 0; i < POE_ONEGIN_BUCKET_COUNT; i++)
+    generator->buckets[i].stringPairCount = bucketSize;
+  generator->stringPairCount = bucketSize * POE_ONEGIN_BUCKET_COUNT;
+
+  return POE_ONEGIN_GENERATOR_STATUS_OK;
+} // poeOneginAddStanzas function end
+
+PoeOneginGeneratorStatus POE_API
+poeCreateOneginGenerator(
+  const PoeText *const text,
+  PoeOneginGenerator *const generator,
+  PoeArena *const arena
+) {
+  assert(text != NULL);
+  assert(generator != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
+  memset(generator, 0, sizeof(PoeOneginGenerator));
+  generator->arena = arena;
+
+  switch (poeCreateCompactText(text, &generator->lines, arena)) {
+  case POE_STATUS_OK:
+    break;
+  case POE_STATUS_BAD_ALLOC:
+    return POE_ONEGIN_GENERATOR_STATUS_BAD_ALLOC;
+  default:
+    return POE_ONEGIN_GENERATOR_STATUS_BAD_TEXT;
+  }
 
-  generator->stringPairBuffer = stringPairBuffer;
-  generator->stringPairCount = stringPairCount;
   generator->text = text;
 
-  return POE_ONEGIN_GENERATOR_STATUS_OK;
+  const PoeOneginGeneratorStatus status = poeOneginAddStanzas(generator, 0);
+
+  if (!POE_CHECK(status))
+    poeDestroyOneginGenerator(generator);
+
+  return status;
 } // poeCreateOneginGenerator function end
 
+PoeOneginGeneratorStatus POE_API
+poeOneginGeneratorAppend(
+  PoeOneginGenerator *const generator,
+  const PoeTextAppend *const append
+) {
+  assert(generator != NULL);
+  assert(generator->text != NULL);
+  assert(append != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
+  const size_t firstLine = generator->lines.stringCount;
+
+  switch (poeAppendCompactText(&generator->lines, generator->text, append)) {
+  case POE_STATUS_OK:
+    break;
+  case POE_STATUS_BAD_ALLOC:
+    return POE_ONEGIN_GENERATOR_STATUS_BAD_ALLOC;
+  default:
+    return POE_ONEGIN_GENERATOR_STATUS_BAD_TEXT;
+  }
+
+  return poeOneginAddStanzas(generator, firstLine);
+} // poeOneginGeneratorAppend function end
+
 PoeOneginGeneratorStatus POE_API
 poeOneginGenerateStanza(
   const PoeOneginGenerator *const generator,
-  const PoeString **stanzaBuffer
+  PoeRandom *const random,
+  PoeString *const stanzaBuffer
 ) {
   assert(generator != NULL);
+  assert(random != NULL);
   assert(stanzaBuffer != NULL);
 
+  // all buckets have same size
+  if (generator->buckets[0].stringPairCount == 0)
+    return POE_ONEGIN_GENERATOR_STATUS_NO_STANZAS;
+
+  const PoeCompactText *const lines = &generator->lines;
   const PoeOneginStringPair *pairs[POE_ONEGIN_BUCKET_COUNT];
-  
+
   for (size_t i = 0; i < POE_ONEGIN_BUCKET_COUNT; i++)
-    pairs[i] = generator->buckets[i].stringPairSet + rand() % generator->buckets[i].stringPairCount;
+    pairs[i] = generator->buckets[i].stringPairSet + poeRandomBounded(random, (uint32_t)generator->buckets[i].stringPairCount);
 
-  stanzaBuffer[ 0] = &pairs[0]->first ;
-  stanzaBuffer[ 1] = &pairs[1]->first ;
-  stanzaBuffer[ 2] = &pairs[0]->second;
-  stanzaBuffer[ 3] = &pairs[1]->second;
+  stanzaBuffer[ 0] = poeCompactGetString(lines, pairs[0]->first );
+  stanzaBuffer[ 1] = poeCompactGetString(lines, pairs[1]->first );
+  stanzaBuffer[ 2] = poeCompactGetString(lines, pairs[0]->second);
+  stanzaBuffer[ 3] = poeCompactGetString(lines, pairs[1]->second);
 
-  stanzaBuffer[ 4] = &pairs[2]->first ;
-  stanzaBuffer[ 5] = &pairs[2]->second;
-  stanzaBuffer[ 6] = &pairs[3]->first ;
-  stanzaBuffer[ 7] = &pairs[3]->second;
+  stanzaBuffer[ 4] = poeCompactGetString(lines, pairs[2]->first );
+  stanzaBuffer[ 5] = poeCompactGetString(lines, pairs[2]->second);
+  stanzaBuffer[ 6] = poeCompactGetString(lines, pairs[3]->first );
+  stanzaBuffer[ 7] = poeCompactGetString(lines, pairs[3]->second);
 
-  stanzaBuffer[ 8] = &pairs[4]->first ;
-  stanzaBuffer[ 9] = &pairs[5]->first ;
-  stanzaBuffer[10] = &pairs[5]->second;
-  stanzaBuffer[11] = &pairs[4]->second;
+  stanzaBuffer[ 8] = poeCompactGetString(lines, pairs[4]->first );
+  stanzaBuffer[ 9] = poeCompactGetString(lines, pairs[5]->first );
+  stanzaBuffer[10] = poeCompactGetString(lines, pairs[5]->second);
+  stanzaBuffer[11] = poeCompactGetString(lines, pairs[4]->second);
 
-  stanzaBuffer[12] = &pairs[6]->first;
-  stanzaBuffer[13] = &pairs[6]->second;
+  stanzaBuffer[12] = poeCompactGetString(lines, pairs[6]->first );
+  stanzaBuffer[13] = poeCompactGetString(lines, pairs[6]->second);
 
   return POE_ONEGIN_GENERATOR_STATUS_OK;
 } // poeOneginGenerateStanza function end
 
+/// stanza batch generation context representation structure
+typedef struct __PoeOneginBatchContext {
+  const PoeOneginGenerator * generator;    ///< generator
+  PoeString                * stanzaBuffer; ///< stanza lines buffer
+} PoeOneginBatchContext;
+
+/**
+ * @brief batch stanza generation function
+ * 
+ * @param context     batch context
+ * @param random      random stream
+ * @param stanzaIndex index of stanza to generate
+ * 
+ * @return POE_TRUE if generated, POE_FALSE otherwise
+ */
+static PoeBool POE_API
+poeOneginGenerateBatchStanza( void *const context, PoeRandom *const random, const size_t stanzaIndex ) {
+  const PoeOneginBatchContext *const batch = (const PoeOneginBatchContext *)context;
+
+  return POE_CHECK(poeOneginGenerateStanza(batch->generator, random, batch->stanzaBuffer + stanzaIndex * POE_STANZA_LINE_COUNT));
+} // poeOneginGenerateBatchStanza function end
+
+PoeOneginGeneratorStatus POE_API
+poeOneginGenerateStanzas(
+  const PoeOneginGenerator *const generator,
+  const size_t stanzaCount,
+  const uint64_t seed,
+  const size_t threadCount,
+  PoeString *const stanzaBuffer
+) {
+  assert(generator != NULL);
+  assert(stanzaBuffer != NULL || stanzaCount == 0);
+
+  if (stanzaCount != 0 && generator->buckets[0].stringPairCount == 0)
+    return POE_ONEGIN_GENERATOR_STATUS_NO_STANZAS;
+
+  PoeOneginBatchContext batch = {
+    .generator = generator,
+    .stanzaBuffer = stanzaBuffer,
+  };
+
+  poeRandomGenerateBatch(stanzaCount, seed, threadCount, poeOneginGenerateBatchStanza, &batch);
+
+  return POE_ONEGIN_GENERATOR_STATUS_OK;
+} // poeOneginGenerateStanzas function end
+
 void POE_API
 poeDestroyOneginGenerator(
   PoeOneginGenerator *const generator
 ) {
   assert(generator != NULL);
 
-  free(generator->stringPairBuffer);
+  if (generator->snapshot.data != NULL)
+    poeUnmapFile(&generator->snapshot);
+  poeArenaFree(generator->arena, generator->stringPairBuffer);
+  poeDestroyCompactText(&generator->lines);
 } // poeDestroyOneginGenerator function end
 
 // poe_onegin_generator.cpp file end
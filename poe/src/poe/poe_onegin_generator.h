@@ -8,17 +8,19 @@
 #define POE_ONEGIN_GENERATOR_H_
 
 #include "poe_compare.h"
+#include "poe_compact.h"
+#include "poe_random.h"
 
 /// just string pair, actually
 typedef struct __PoeOneginStringPair {
-  PoeString first;  ///< first string
-  PoeString second; ///< second string
+  uint32_t first;  ///< first string index (in text initial order)
+  uint32_t second; ///< second string index (in text initial order)
 } PoeOneginStringPair;
 
 /// generator bucket
 typedef struct __PoeOneginBucket {
-  PoeOneginStringPair * stringPairSet;   ///< string set
-  size_t                stringPairCount; ///< count of strings in set
+  const PoeOneginStringPair * stringPairSet;   ///< string set
+  size_t                      stringPairCount; ///< count of strings in set
 } PoeOneginBucket;
 
 /// count of buckets
@@ -27,14 +29,20 @@ typedef struct __PoeOneginBucket {
 /// text generator
 typedef struct __PoeOneginGenerator {
   const PoeText       * text;                             ///< text strings string pair buffer refers to
-  PoeOneginStringPair * stringPairBuffer;                 ///< string pair bulk allocation
+  PoeCompactText        lines;                            ///< text strings in initial order (pairs refer to them, so text may be sorted)
+  PoeOneginStringPair * stringPairBuffer;                 ///< string pair bulk allocation (NULL if pairs refer to snapshot)
   size_t                stringPairCount;                  ///< pair count
+  size_t                stringPairCapacity;               ///< count of pairs allocated for every bucket (bucket i starts at i * stringPairCapacity)
   PoeOneginBucket       buckets[POE_ONEGIN_BUCKET_COUNT]; ///< string buckets
+  PoeFileMapping        snapshot;                         ///< snapshot mapping pairs refer to (zeroed if generator is not loaded)
+  PoeArena            * arena;                            ///< arena lines and string pairs are allocated from (NULL if they are heap ones)
 } PoeOneginGenerator;
 
 /// Generator create status
 typedef enum __PoeOneginGeneratorStatus {
   POE_DEFINE_COMMON_STATUS(POE_ONEGIN_GENERATOR_STATUS)
+  POE_ONEGIN_GENERATOR_STATUS_NO_STANZAS = 2, ///< Text contains no stanzas to generate from
+  POE_ONEGIN_GENERATOR_STATUS_BAD_TEXT   = 3, ///< Text can't be represented compactly (see poeCreateCompactText)
 } PoeOneginGeneratorStatus;
 
 /**
@@ -42,29 +50,72 @@ typedef enum __PoeOneginGeneratorStatus {
  * 
  * @param text      text to generate stanza from
  * @param generator generator to generate text by
+ * @param arena     arena to allocate generator from (NULL for heap)
  * 
- * @note text must be built from 14-line Onegin stanzas
+ * @note text must be built from 14-line Onegin stanzas; stanzas are detected in text initial order,
+ *       so generator may be created after text sorting too
  * 
  * @return status
  */
 PoeOneginGeneratorStatus POE_API
 poeCreateOneginGenerator(
   const PoeText *text,
-  PoeOneginGenerator *generator
+  PoeOneginGenerator *generator,
+  PoeArena *arena
+);
+
+/**
+ * @brief generator by appended text strings updating function
+ * 
+ * @param generator generator of text strings were appended to by poeAppendText
+ * @param append    append result
+ * 
+ * @note appended strings must not be reordered yet. Only stanzas that end in appended strings are
+ *       detected and buckets grow geometrically, so cost is proportional to count of appended strings;
+ *       generator is the same as if it was created for whole text, so it generates same stanzas by same seed
+ * 
+ * @return status (generator may be destroyed only if failed)
+ */
+PoeOneginGeneratorStatus POE_API
+poeOneginGeneratorAppend(
+  PoeOneginGenerator *generator,
+  const PoeTextAppend *append
 );
 
 /**
  * @brief stanza generation function
  * 
  * @param generator    generator to generate stanza by
- * @param stanzaBuffer buffer to write answer (note: minimal accepted size of buffer is 14)
+ * @param random       random stream to choose lines by
+ * @param stanzaBuffer buffer to write answer (note: minimal accepted size of buffer is POE_STANZA_LINE_COUNT)
  * 
  * @return status
  */
 PoeOneginGeneratorStatus POE_API
 poeOneginGenerateStanza(
   const PoeOneginGenerator *generator,
-  const PoeString **stanzaBuffer
+  PoeRandom *random,
+  PoeString *stanzaBuffer
+);
+
+/**
+ * @brief stanza batch generation function
+ * 
+ * @param generator    generator to generate stanzas by
+ * @param stanzaCount  count of stanzas to generate
+ * @param seed         random seed (same seed gives same stanzas regardless of thread count)
+ * @param threadCount  count of threads to generate on (0 for hardware thread count)
+ * @param stanzaBuffer buffer to write stanza lines to (stanzaCount * POE_STANZA_LINE_COUNT elements)
+ * 
+ * @return status
+ */
+PoeOneginGeneratorStatus POE_API
+poeOneginGenerateStanzas(
+  const PoeOneginGenerator *generator,
+  size_t stanzaCount,
+  uint64_t seed,
+  size_t threadCount,
+  PoeString *stanzaBuffer
 );
 
 /**
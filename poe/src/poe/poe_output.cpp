@@ -0,0 +1,227 @@
+/**
+ * @file   poe/poe_output.cpp
+ * @author tiot2
+ * @brief  Poem processor stanza output implementation module
+ */
+
+#include "poe_output.h"
+#include "poe_arena.h"
+#include "poe_stats.h"
+
+#ifndef _WIN32
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif // !defined(_WIN32)
+
+void POE_API
+poeDestroyOutputBuffer( PoeOutputBuffer *const buffer ) {
+  assert(buffer != NULL);
+
+  free(buffer->data);
+  memset(buffer, 0, sizeof(PoeOutputBuffer));
+} // poeDestroyOutputBuffer function end
+
+/**
+ * @brief rendered stanza size getting function
+ *
+ * @param lines stanza lines (POE_STANZA_LINE_COUNT elements)
+ *
+ * @return size of rendered stanza
+ */
+static size_t
+poeOutputGetStanzaSize( const PoeString *const lines ) {
+  // every line and stanza itself are followed by '\n'
+  size_t size = POE_STANZA_LINE_COUNT + 1;
+
+  for (size_t i = 0; i < POE_STANZA_LINE_COUNT; i++)
+    size += lines[i].end - lines[i].begin;
+
+  return size;
+} // poeOutputGetStanzaSize function end
+
+/**
+ * @brief stanza rendering function
+ *
+ * @param lines stanza lines (POE_STANZA_LINE_COUNT elements)
+ * @param dst   destination (at least poeOutputGetStanzaSize(lines) bytes)
+ *
+ * @return pointer to byte after rendered stanza
+ */
+static char *
+poeOutputRenderStanza( const PoeString *const lines, char *dst ) {
+  for (size_t i = 0; i < POE_STANZA_LINE_COUNT; i++) {
+    const size_t size = lines[i].end - lines[i].begin;
+
+    memcpy(dst, lines[i].begin, size);
+    dst += size;
+    *dst++ = '\n';
+  }
+  *dst++ = '\n';
+
+  return dst;
+} // poeOutputRenderStanza function end
+
+PoeStatus POE_API
+poeRenderStanzas( const PoeString *const lines, const size_t stanzaCount, PoeOutputBuffer *const buffer ) {
+  assert(lines != NULL || stanzaCount == 0);
+  assert(buffer != NULL);
+
+  size_t size = buffer->size;
+
+  for (size_t i = 0; i < stanzaCount; i++)
+    size += poeOutputGetStanzaSize(lines + i * POE_STANZA_LINE_COUNT);
+
+  if (size > buffer->capacity) {
+    size_t capacity = buffer->capacity == 0 ? 256 : buffer->capacity;
+
+    while (capacity < size)
+      capacity *= 2;
+
+    char *const data = (char *)poeArenaReallocate(NULL, buffer->data, buffer->capacity, capacity);
+
+    if (data == NULL)
+      return POE_STATUS_BAD_ALLOC;
+
+    buffer->data = data;
+    buffer->capacity = capacity;
+  }
+
+  char *iter = buffer->data + buffer->size;
+
+  for (size_t i = 0; i < stanzaCount; i++)
+    iter = poeOutputRenderStanza(lines + i * POE_STANZA_LINE_COUNT, iter);
+
+  buffer->size = size;
+
+  return POE_STATUS_OK;
+} // poeRenderStanzas function end
+
+#ifndef _WIN32
+
+/**
+ * @brief whole iovec list writing function
+ *
+ * @param fd    file descriptor to write to
+ * @param iov   iovec list (modified in case of partial write)
+ * @param count count of iovec list entries
+ *
+ * @return POE_TRUE if everything is written, POE_FALSE otherwise
+ */
+static PoeBool
+poeOutputWritevAll( const int fd, struct iovec *iov, size_t count ) {
+  while (count != 0) {
+    const ssize_t written = writev(fd, iov, (int)count);
+
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return POE_FALSE;
+    }
+
+    // skip completely written entries and move into partially written one
+    size_t left = (size_t)written;
+
+    while (count != 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      iov++;
+      count--;
+    }
+
+    if (count != 0) {
+      iov->iov_base = (char *)iov->iov_base + left;
+      iov->iov_len -= left;
+    }
+  }
+
+  return POE_TRUE;
+} // poeOutputWritevAll function end
+
+PoeStatus POE_API
+poeWriteStanzas( FILE *const file, const PoeString *const lines, const size_t stanzaCount, PoeOutputBuffer *const buffer ) {
+  assert(file != NULL);
+  assert(lines != NULL || stanzaCount == 0);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_WRITE);
+
+  // unused, as lines are written straight from text buffer
+  (void)buffer;
+
+  static char newline = '\n';
+  struct iovec iov[POE_OUTPUT_IOVEC_COUNT];
+  size_t iovCount = 0;
+  const int fd = fileno(file);
+
+  // data buffered in file before must go first
+  if (fflush(file) != 0)
+    return POE_STATUS_IO_ERROR;
+
+  for (size_t stanzaIndex = 0; stanzaIndex < stanzaCount; stanzaIndex++) {
+    const PoeString *const stanza = lines + stanzaIndex * POE_STANZA_LINE_COUNT;
+
+    // whole stanza must fit: line and '\n' for every line and trailing '\n'
+    if (iovCount + POE_STANZA_LINE_COUNT * 2 + 1 > POE_OUTPUT_IOVEC_COUNT) {
+      if (!poeOutputWritevAll(fd, iov, iovCount))
+        return POE_STATUS_IO_ERROR;
+      iovCount = 0;
+    }
+
+    for (size_t i = 0; i < POE_STANZA_LINE_COUNT; i++) {
+      iov[iovCount].iov_base = stanza[i].begin;
+      iov[iovCount].iov_len = stanza[i].end - stanza[i].begin;
+      iovCount += iov[iovCount].iov_len != 0;
+
+      iov[iovCount].iov_base = &newline;
+      iov[iovCount].iov_len = 1;
+      iovCount++;
+    }
+
+    iov[iovCount].iov_base = &newline;
+    iov[iovCount].iov_len = 1;
+    iovCount++;
+  }
+
+  return poeOutputWritevAll(fd, iov, iovCount) ? POE_STATUS_OK : POE_STATUS_IO_ERROR;
+} // poeWriteStanzas function end
+
+#else // defined(_WIN32)
+
+PoeStatus POE_API
+poeWriteStanzas( FILE *const file, const PoeString *const lines, const size_t stanzaCount, PoeOutputBuffer *const buffer ) {
+  assert(file != NULL);
+  assert(lines != NULL || stanzaCount == 0);
+  assert(buffer != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_WRITE);
+
+  size_t stanzaIndex = 0;
+
+  while (stanzaIndex < stanzaCount) {
+    // gather stanzas of chunk (at least one)
+    size_t chunkEnd = stanzaIndex;
+    size_t chunkSize = 0;
+
+    do
+      chunkSize += poeOutputGetStanzaSize(lines + chunkEnd++ * POE_STANZA_LINE_COUNT);
+    while (chunkEnd < stanzaCount && chunkSize < POE_OUTPUT_CHUNK_SIZE);
+
+    buffer->size = 0;
+
+    PoeStatus status = poeRenderStanzas(lines + stanzaIndex * POE_STANZA_LINE_COUNT, chunkEnd - stanzaIndex, buffer);
+    if (!POE_CHECK(status))
+      return status;
+
+    if (fwrite(buffer->data, 1, buffer->size, file) != buffer->size)
+      return POE_STATUS_IO_ERROR;
+
+    stanzaIndex = chunkEnd;
+  }
+
+  buffer->size = 0;
+
+  return fflush(file) == 0 ? POE_STATUS_OK : POE_STATUS_IO_ERROR;
+} // poeWriteStanzas function end
+
+#endif // !defined(_WIN32)
+
+// poe_output.cpp file end
@@ -0,0 +1,67 @@
+/**
+ * @file   poe/poe_output.h
+ * @author tiot2
+ * @brief  Poem processor stanza output declaration module
+ */
+
+#ifndef POE_OUTPUT_H_
+#define POE_OUTPUT_H_
+
+#include "poe_core.h"
+
+/// size of rendered data written at once by poeWriteStanzas (where scatter-gather output is unavailable)
+#define POE_OUTPUT_CHUNK_SIZE ((size_t)1 << 20)
+
+/// count of iovec entries written at once by poeWriteStanzas
+#define POE_OUTPUT_IOVEC_COUNT 1024
+
+/// reusable caller-owned output buffer representation structure
+typedef struct __PoeOutputBuffer {
+  char   * data;     ///< buffer data (NULL if nothing was allocated yet)
+  size_t   size;     ///< count of used bytes
+  size_t   capacity; ///< count of allocated bytes
+} PoeOutputBuffer;
+
+/**
+ * @brief output buffer destroy function
+ *
+ * @param buffer buffer to destroy (zero-initialized buffers may be destroyed too)
+ */
+void POE_API
+poeDestroyOutputBuffer( PoeOutputBuffer *buffer );
+
+/**
+ * @brief stanzas to output buffer rendering function
+ *
+ * @param lines       stanza lines (stanzaCount * POE_STANZA_LINE_COUNT elements)
+ * @param stanzaCount count of stanzas to render
+ * @param buffer      buffer to append stanzas to (grows only if its capacity is not enough)
+ *
+ * @note lines are '\n'-terminated, every stanza is followed by empty line
+ *
+ * @return operation status
+ */
+PoeStatus POE_API
+poeRenderStanzas( const PoeString *lines, size_t stanzaCount, PoeOutputBuffer *buffer );
+
+/**
+ * @brief stanzas writing function
+ *
+ * @param file        file to write stanzas to
+ * @param lines       stanza lines (stanzaCount * POE_STANZA_LINE_COUNT elements)
+ * @param stanzaCount count of stanzas to write
+ * @param buffer      render buffer (used only where scatter-gather output is unavailable)
+ *
+ * @note on POSIX systems lines are written straight from text buffer by writev in batches of
+ *       POE_OUTPUT_IOVEC_COUNT entries; otherwise stanzas are rendered into buffer by
+ *       POE_OUTPUT_CHUNK_SIZE chunks and each chunk is written at once. Output format matches
+ *       poeRenderStanzas one.
+ *
+ * @return operation status
+ */
+PoeStatus POE_API
+poeWriteStanzas( FILE *file, const PoeString *lines, size_t stanzaCount, PoeOutputBuffer *buffer );
+
+#endif // !defined(POE_OUTPUT_H_)
+
+// poe_output.h file end
@@ -0,0 +1,87 @@
+/**
+ * @file   poe/poe_packed.cpp
+ * @author tiot2
+ * @brief  Poem processor packed record sort implementation module
+ */
+
+#include "poe.h"
+
+static_assert(sizeof(PoePackedRecord) == 12, "packed record must not be padded");
+
+/**
+ * @brief packed records compare functor
+ * 
+ * @tparam StringComparator string comparator used if prefixes do not decide ordering
+ */
+template <typename StringComparator>
+struct PoePackedRecordComparator {
+  const PoeString  * strings;        ///< strings records refer to
+  StringComparator   compareStrings; ///< string comparator
+
+  /**
+   * @brief compare operator
+   * 
+   * @param lhs left hand side
+   * @param rhs right hand side
+   * 
+   * @return ordering
+   */
+  inline PoeOrdering
+  operator()( const PoePackedRecord *const lhs, const PoePackedRecord *const rhs ) const {
+    if (lhs->prefix != rhs->prefix)
+      return lhs->prefix < rhs->prefix ? POE_ORDERING_LESS : POE_ORDERING_MORE;
+
+    // equal prefixes of keys shorter than 8 characters mean equal keys
+    if ((lhs->prefix & 0xFF) == 0)
+      return POE_ORDERING_EQUAL;
+
+    return compareStrings(strings + lhs->index, strings + rhs->index);
+  } // operator() end
+}; // struct PoePackedRecordComparator end
+
+PoeStatus POE_API
+poeSortTextPacked( PoeText *const text, const PoeKeyOrder order ) {
+  assert(text != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  if (text->stringCount > UINT32_MAX) {
+    poeSortText(text, order == POE_KEY_ORDER_FORWARD ? poeCompareFromStart : poeCompareFromEnd);
+    return POE_STATUS_OK;
+  }
+
+  if (text->stringCount < 2)
+    return POE_STATUS_OK;
+
+  PoePackedRecord *records = (PoePackedRecord *)poeArenaAllocateZeroed(NULL, text->stringCount, sizeof(PoePackedRecord));
+  PoeString *sortedStrings = (PoeString *)poeArenaAllocateZeroed(NULL, text->stringCount, sizeof(PoeString));
+
+  if (records == NULL || sortedStrings == NULL) {
+    free(records);
+    free(sortedStrings);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  for (size_t i = 0; i < text->stringCount; i++) {
+    records[i].prefix = poeGetKeyPrefix(text->strings + i, order);
+    records[i].index = (uint32_t)i;
+  }
+
+  if (order == POE_KEY_ORDER_FORWARD)
+    poeTextHybridSort(records, records + text->stringCount, PoePackedRecordComparator<PoeCompareFromStartFunctor> {text->strings}, POE_TRUE);
+  else
+    poeTextHybridSort(records, records + text->stringCount, PoePackedRecordComparator<PoeCompareFromEndFunctor> {text->strings}, POE_TRUE);
+
+  // materialize order
+  for (size_t i = 0; i < text->stringCount; i++)
+    sortedStrings[i] = text->strings[records[i].index];
+
+  memcpy(text->strings, sortedStrings, text->stringCount * sizeof(PoeString));
+
+  free(sortedStrings);
+  free(records);
+
+  return POE_STATUS_OK;
+} // poeSortTextPacked function end
+
+// poe_packed.cpp file end
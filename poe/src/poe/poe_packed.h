@@ -0,0 +1,41 @@
+/**
+ * @file   poe/poe_packed.h
+ * @author tiot2
+ * @brief  Poem processor packed record sort declaration module
+ */
+
+#ifndef POE_PACKED_H_
+#define POE_PACKED_H_
+
+#include "poe_key.h"
+
+#pragma pack(push, 4)
+
+/// packed sort record representation structure
+typedef struct __PoePackedRecord {
+  uint64_t prefix; ///< string key prefix (see poeGetKeyPrefix)
+  uint32_t index;  ///< string index before sort
+} PoePackedRecord;
+
+#pragma pack(pop)
+
+/**
+ * @brief text by packed records sorting function
+ * 
+ * @param text  text to sort
+ * @param order sort order
+ * 
+ * @note strings are sorted as 12-byte records of key prefix and string index, so strings
+ *       are accessed only if prefixes are equal and longer than 8 characters keys are possible;
+ *       sorted order is written back to text strings then. Ordering is the same as poeSortText
+ *       with poeCompareFromStart (poeCompareFromEnd for POE_KEY_ORDER_REVERSE) gives.
+ *       Texts with more than UINT32_MAX strings are sorted by poeSortText.
+ * 
+ * @return operation status (text is not changed in case of failure)
+ */
+PoeStatus POE_API
+poeSortTextPacked( PoeText *text, PoeKeyOrder order );
+
+#endif // !defined(POE_PACKED_H_)
+
+// poe_packed.h file end
@@ -0,0 +1,211 @@
+/**
+ * @file   poe/poe_parallel.cpp
+ * @author tiot2
+ * @brief  Poem processor parallel execution implementation module
+ */
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "poe_parallel.h"
+#include "poe_stats.h"
+
+/// maximal count of threads
+#define POE_PARALLEL_MAX_THREAD_COUNT 256
+
+size_t POE_API
+poeParallelGetHardwareThreadCount( void ) {
+  const size_t count = std::thread::hardware_concurrency();
+
+  return count == 0 ? 1 : count;
+} // poeParallelGetHardwareThreadCount function end
+
+void POE_API
+poeParallelFor( const size_t taskCount, size_t threadCount, const PoeParallelTaskFn taskFn, void *const context ) {
+  assert(taskFn != NULL);
+
+  if (threadCount == 0)
+    threadCount = poeParallelGetHardwareThreadCount();
+  if (threadCount > taskCount)
+    threadCount = taskCount;
+  if (threadCount > POE_PARALLEL_MAX_THREAD_COUNT)
+    threadCount = POE_PARALLEL_MAX_THREAD_COUNT;
+
+  // no reason to start threads
+  if (threadCount <= 1) {
+    for (size_t i = 0; i < taskCount; i++)
+      taskFn(context, i);
+    return;
+  }
+
+  std::atomic<size_t> nextTask = 0;
+
+  auto worker = [&]( void ) {
+    for (size_t task; (task = nextTask.fetch_add(1, std::memory_order_relaxed)) < taskCount; )
+      taskFn(context, task);
+    poeStatsFlushThread();
+  };
+
+  std::thread threads[POE_PARALLEL_MAX_THREAD_COUNT];
+
+  // calling thread is worker too
+  for (size_t i = 1; i < threadCount; i++)
+    threads[i] = std::thread(worker);
+  worker();
+
+  for (size_t i = 1; i < threadCount; i++)
+    threads[i].join();
+} // poeParallelFor function end
+
+/// work-stealing scheduler task representation structure
+typedef struct __PoeParallelTask {
+  PoeParallelRangeTaskFn   taskFn;  ///< task function
+  void                   * context; ///< task context
+  size_t                   begin;   ///< range begin
+  size_t                   end;     ///< range end
+} PoeParallelTask;
+
+/// work-stealing scheduler representation structure
+typedef struct __PoeParallelScheduler {
+  PoeParallelWorker   * workers;      ///< workers
+  size_t                workerCount;  ///< count of workers
+  std::atomic<size_t>   pendingCount; ///< count of spawned but not finished tasks
+} PoeParallelScheduler;
+
+/// work-stealing scheduler worker representation structure
+struct __PoeParallelWorker {
+  PoeParallelScheduler        * scheduler; ///< scheduler worker belongs to
+  size_t                        index;     ///< worker index
+  std::mutex                    mutex;     ///< task deque mutex
+  std::deque<PoeParallelTask>   tasks;     ///< task deque (owner works with back, thieves with front)
+};
+
+void POE_API
+poeParallelSpawn(
+  PoeParallelWorker *const worker,
+  const PoeParallelRangeTaskFn taskFn,
+  void *const context,
+  const size_t begin,
+  const size_t end
+) {
+  assert(worker != NULL);
+  assert(taskFn != NULL);
+
+  worker->scheduler->pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(worker->mutex);
+  worker->tasks.push_back(PoeParallelTask { taskFn, context, begin, end });
+} // poeParallelSpawn function end
+
+/**
+ * @brief task for execution getting function
+ * 
+ * @param worker worker to get task for
+ * @param task   task destination
+ * 
+ * @return POE_TRUE if task found, POE_FALSE otherwise
+ */
+static PoeBool
+poeParallelGetTask( PoeParallelWorker *const worker, PoeParallelTask *const task ) {
+  // own tasks are taken from back (the most recently spawned, smallest ones)
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+
+    if (!worker->tasks.empty()) {
+      *task = worker->tasks.back();
+      worker->tasks.pop_back();
+      return POE_TRUE;
+    }
+  }
+
+  // other workers' tasks are stolen from front (the oldest, largest ones)
+  PoeParallelScheduler *const scheduler = worker->scheduler;
+
+  for (size_t i = 1; i < scheduler->workerCount; i++) {
+    PoeParallelWorker *const victim = scheduler->workers + (worker->index + i) % scheduler->workerCount;
+    std::lock_guard<std::mutex> lock(victim->mutex);
+
+    if (!victim->tasks.empty()) {
+      *task = victim->tasks.front();
+      victim->tasks.pop_front();
+      return POE_TRUE;
+    }
+  }
+
+  return POE_FALSE;
+} // poeParallelGetTask function end
+
+/**
+ * @brief worker main loop function
+ * 
+ * @param worker worker to run
+ */
+static void
+poeParallelWorkerMain( PoeParallelWorker *const worker ) {
+  PoeParallelScheduler *const scheduler = worker->scheduler;
+  PoeParallelTask task;
+
+  while (scheduler->pendingCount.load(std::memory_order_acquire) != 0) {
+    if (!poeParallelGetTask(worker, &task)) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    task.taskFn(worker, task.context, task.begin, task.end);
+    scheduler->pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  poeStatsFlushThread();
+} // poeParallelWorkerMain function end
+
+PoeBool POE_API
+poeParallelRun(
+  size_t threadCount,
+  const PoeParallelRangeTaskFn taskFn,
+  void *const context,
+  const size_t begin,
+  const size_t end
+) {
+  assert(taskFn != NULL);
+
+  if (threadCount == 0)
+    threadCount = poeParallelGetHardwareThreadCount();
+  if (threadCount > POE_PARALLEL_MAX_THREAD_COUNT)
+    threadCount = POE_PARALLEL_MAX_THREAD_COUNT;
+
+  PoeParallelScheduler scheduler;
+  PoeParallelWorker *workers = new (std::nothrow) PoeParallelWorker[threadCount];
+
+  if (workers == NULL)
+    return POE_FALSE;
+
+  scheduler.workers = workers;
+  scheduler.workerCount = threadCount;
+  scheduler.pendingCount.store(0);
+
+  for (size_t i = 0; i < threadCount; i++) {
+    workers[i].scheduler = &scheduler;
+    workers[i].index = i;
+  }
+
+  poeParallelSpawn(workers, taskFn, context, begin, end);
+
+  std::thread threads[POE_PARALLEL_MAX_THREAD_COUNT];
+
+  // calling thread is worker too
+  for (size_t i = 1; i < threadCount; i++)
+    threads[i] = std::thread(poeParallelWorkerMain, workers + i);
+  poeParallelWorkerMain(workers);
+
+  for (size_t i = 1; i < threadCount; i++)
+    threads[i].join();
+
+  delete[] workers;
+
+  return POE_TRUE;
+} // poeParallelRun function end
+
+// poe_parallel.cpp file end
@@ -0,0 +1,84 @@
+/**
+ * @file   poe/poe_parallel.h
+ * @author tiot2
+ * @brief  Poem processor parallel execution declaration module
+ */
+
+#ifndef POE_PARALLEL_H_
+#define POE_PARALLEL_H_
+
+#include "poe_core.h"
+
+/**
+ * @brief parallel task function pointer definition
+ * 
+ * @param context   user context
+ * @param taskIndex index of task to execute
+ */
+typedef void (POE_API * PoeParallelTaskFn)( void *context, size_t taskIndex );
+
+/**
+ * @brief hardware thread count getting function
+ * 
+ * @return count of hardware threads (at least 1)
+ */
+size_t POE_API
+poeParallelGetHardwareThreadCount( void );
+
+/**
+ * @brief parallel for-each function
+ * 
+ * @param taskCount   count of tasks to execute
+ * @param threadCount count of threads to execute tasks on (0 for hardware thread count)
+ * @param taskFn      task function
+ * @param context     task function context
+ * 
+ * @note calling thread takes part in execution; returns after all tasks are finished
+ */
+void POE_API
+poeParallelFor( size_t taskCount, size_t threadCount, PoeParallelTaskFn taskFn, void *context );
+
+/// work-stealing scheduler worker (opaque)
+typedef struct __PoeParallelWorker PoeParallelWorker;
+
+/**
+ * @brief range task function pointer definition
+ * 
+ * @param worker  worker task is executed on (used to spawn subtasks)
+ * @param context user context
+ * @param begin   range begin
+ * @param end     range end
+ */
+typedef void (POE_API * PoeParallelRangeTaskFn)( PoeParallelWorker *worker, void *context, size_t begin, size_t end );
+
+/**
+ * @brief task on work-stealing scheduler running function
+ * 
+ * @param threadCount count of threads (0 for hardware thread count)
+ * @param taskFn      root task function
+ * @param context     root task context
+ * @param begin       root task range begin
+ * @param end         root task range end
+ * 
+ * @note returns after root task and all tasks spawned from it are finished
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE if scheduler allocation failed
+ */
+PoeBool POE_API
+poeParallelRun( size_t threadCount, PoeParallelRangeTaskFn taskFn, void *context, size_t begin, size_t end );
+
+/**
+ * @brief subtask spawning function
+ * 
+ * @param worker  worker to spawn task on (task may be stolen by other workers)
+ * @param taskFn  task function
+ * @param context task context
+ * @param begin   task range begin
+ * @param end     task range end
+ */
+void POE_API
+poeParallelSpawn( PoeParallelWorker *worker, PoeParallelRangeTaskFn taskFn, void *context, size_t begin, size_t end );
+
+#endif // !defined(POE_PARALLEL_H_)
+
+// poe_parallel.h file end
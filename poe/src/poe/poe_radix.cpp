@@ -0,0 +1,319 @@
+/**
+ * @file   poe/poe_radix.cpp
+ * @author tiot2
+ * @brief  Poem processor string radix sort implementation module
+ */
+
+#include "poe.h"
+
+/// maximal count of records sorted by insertion sort
+#define POE_RADIX_INSERTION_SORT_THRESHOLD 16
+
+/**
+ * @brief key character at depth getting function
+ * 
+ * @param record record to get character of
+ * @param depth  character index
+ * 
+ * @return character ('\0' if key is shorter, so shorter keys go first)
+ */
+static inline unsigned char
+poeRadixGetCharacter( const PoeKeyedRecord *const record, const size_t depth ) {
+  return depth < record->key.size ? record->key.begin[depth] : '\0';
+} // poeRadixGetCharacter function end
+
+/**
+ * @brief records with common prefix insertion sort function
+ * 
+ * @param records     records to sort
+ * @param recordCount count of records
+ * @param depth       size of common key prefix
+ */
+static void
+poeRadixInsertionSort( PoeKeyedRecord *const records, const size_t recordCount, const size_t depth ) {
+  for (size_t i = 1; i < recordCount; i++) {
+    const PoeKeyedRecord record = records[i];
+    const PoeSortKey suffix = { record.key.begin + depth, record.key.size - depth };
+    size_t j = i;
+
+    while (j > 0) {
+      const PoeSortKey otherSuffix = { records[j - 1].key.begin + depth, records[j - 1].key.size - depth };
+
+      if (poeCompareKeys(&otherSuffix, &suffix) != POE_ORDERING_MORE)
+        break;
+
+      records[j] = records[j - 1];
+      j--;
+    }
+
+    records[j] = record;
+  }
+} // poeRadixInsertionSort function end
+
+/**
+ * @brief records swapping function
+ * 
+ * @param lhs first record
+ * @param rhs second record
+ */
+static inline void
+poeRadixSwap( PoeKeyedRecord *const lhs, PoeKeyedRecord *const rhs ) {
+  const PoeKeyedRecord tmp = *lhs;
+
+  *lhs = *rhs;
+  *rhs = tmp;
+} // poeRadixSwap function end
+
+/**
+ * @brief median of three characters getting function
+ * 
+ * @param a first character
+ * @param b second character
+ * @param c third character
+ * 
+ * @return median
+ */
+static inline unsigned char
+poeRadixMedian( const unsigned char a, const unsigned char b, const unsigned char c ) {
+  if (a < b)
+    return b < c ? b : a < c ? c : a;
+  return a < c ? a : b < c ? c : b;
+} // poeRadixMedian function end
+
+/**
+ * @brief multikey quicksort function
+ * 
+ * @param records     records to sort
+ * @param recordCount count of records
+ * @param depth       size of common key prefix of all records
+ */
+static void
+poeRadixMultikeyQsort( PoeKeyedRecord *records, size_t recordCount, size_t depth ) {
+  // partition with equal character is processed iteratively, so recursion depth doesn't depend on key size
+  while (recordCount > POE_RADIX_INSERTION_SORT_THRESHOLD) {
+    const unsigned char pivot = poeRadixMedian(
+      poeRadixGetCharacter(records, depth),
+      poeRadixGetCharacter(records + recordCount / 2, depth),
+      poeRadixGetCharacter(records + recordCount - 1, depth)
+    );
+
+    // Dijkstra 3-way partition: [0, lt) < pivot, [lt, i) == pivot, (gt, end) > pivot
+    size_t lt = 0, i = 0, gt = recordCount;
+
+    while (i < gt) {
+      const unsigned char c = poeRadixGetCharacter(records + i, depth);
+
+      if (c < pivot)
+        poeRadixSwap(records + lt++, records + i++);
+      else if (c > pivot)
+        poeRadixSwap(records + i, records + --gt);
+      else
+        i++;
+    }
+
+    poeRadixMultikeyQsort(records, lt, depth);
+    poeRadixMultikeyQsort(records + gt, recordCount - gt, depth);
+
+    // all keys in equal partition are over, so they're equal
+    if (pivot == '\0')
+      return;
+
+    records += lt;
+    recordCount = gt - lt;
+    depth++;
+  }
+
+  poeRadixInsertionSort(records, recordCount, depth);
+} // poeRadixMultikeyQsort function end
+
+void POE_API
+poeSortKeyedRecordsRadix( PoeKeyedRecord *const records, const size_t recordCount ) {
+  assert(records != NULL || recordCount == 0);
+
+  poeRadixMultikeyQsort(records, recordCount, 0);
+} // poeSortKeyedRecordsRadix function end
+
+PoeStatus POE_API
+poeSortTextRadix( PoeText *const text, PoeTextKeys *const keys, const PoeKeyOrder order ) {
+  assert(text != NULL);
+  assert(keys != NULL);
+  assert(keys->keyCount == text->stringCount);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  if (text->stringCount < 2)
+    return POE_STATUS_OK;
+
+  PoeKeyedRecord *records = poeCreateKeyedRecords(keys, order);
+
+  if (records == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  poeSortKeyedRecordsRadix(records, text->stringCount);
+
+  PoeStatus status = poeApplyKeyedRecords(text, keys, records);
+  free(records);
+
+  return status;
+} // poeSortTextRadix function end
+
+/// rhyme sort record representation structure
+typedef struct __PoeRhymeRecord {
+  uint64_t prefix; ///< first 8 reversed key characters (first character in most significant byte)
+  size_t   index;  ///< string index before sort
+} PoeRhymeRecord;
+
+/// maximal size of equal prefix run ordered by comparison sort
+#define POE_RHYME_COMPARISON_SORT_THRESHOLD 32
+
+/**
+ * @brief equal prefix run ordering function
+ * 
+ * @param strings     run strings
+ * @param stringCount count of strings in run
+ * 
+ * @note remaining reversed key parts are extracted once and sorted by multikey quicksort,
+ *       small runs (or all runs, if allocation failed) are ordered by poeSortText
+ */
+static void
+poeRhymeSortRun( PoeString *const strings, const size_t stringCount ) {
+  PoeText run = {0};
+  run.strings = strings;
+  run.stringCount = stringCount;
+
+  if (stringCount <= POE_RHYME_COMPARISON_SORT_THRESHOLD) {
+    poeSortText(&run, poeCompareFromEnd);
+    return;
+  }
+
+  size_t keyBufferSize = 0;
+
+  for (size_t i = 0; i < stringCount; i++)
+    for (const char *iter = strings[i].begin; iter < strings[i].end; iter++)
+      keyBufferSize += poeCompareCheckCharacterComparability((unsigned char)*iter) != POE_FALSE;
+
+  unsigned char *keyBuffer = (unsigned char *)poeArenaAllocate(NULL, keyBufferSize);
+  PoeKeyedRecord *records = (PoeKeyedRecord *)poeArenaAllocateZeroed(NULL, stringCount, sizeof(PoeKeyedRecord));
+  PoeString *sorted = (PoeString *)poeArenaAllocateZeroed(NULL, stringCount, sizeof(PoeString));
+
+  if (keyBuffer == NULL || records == NULL || sorted == NULL) {
+    free(keyBuffer);
+    free(records);
+    free(sorted);
+
+    poeSortText(&run, poeCompareFromEnd);
+    return;
+  }
+
+  // first 8 characters are equal in whole run, so they're skipped
+  unsigned char *keyIter = keyBuffer;
+
+  for (size_t i = 0; i < stringCount; i++) {
+    size_t skipped = 0;
+
+    records[i].key.begin = keyIter;
+    records[i].index = i;
+
+    for (const char *iter = strings[i].end; iter > strings[i].begin; ) {
+      const unsigned char c = (unsigned char)*--iter;
+
+      if (poeCompareCheckCharacterComparability(c) && skipped++ >= 8)
+        *keyIter++ = poeCompareProcessCharacter(c);
+    }
+
+    records[i].key.size = keyIter - records[i].key.begin;
+  }
+
+  poeSortKeyedRecordsRadix(records, stringCount);
+
+  for (size_t i = 0; i < stringCount; i++)
+    sorted[i] = strings[records[i].index];
+  memcpy(strings, sorted, stringCount * sizeof(PoeString));
+
+  free(keyBuffer);
+  free(records);
+  free(sorted);
+} // poeRhymeSortRun function end
+
+PoeStatus POE_API
+poeSortTextRhyme( PoeText *const text ) {
+  assert(text != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  const size_t count = text->stringCount;
+
+  if (count < 2)
+    return POE_STATUS_OK;
+
+  PoeRhymeRecord *records = (PoeRhymeRecord *)poeArenaAllocateZeroed(NULL, count, sizeof(PoeRhymeRecord));
+  PoeRhymeRecord *buffer = (PoeRhymeRecord *)poeArenaAllocateZeroed(NULL, count, sizeof(PoeRhymeRecord));
+  PoeString *strings = (PoeString *)poeArenaAllocateZeroed(NULL, count, sizeof(PoeString));
+
+  if (records == NULL || buffer == NULL || strings == NULL) {
+    free(records);
+    free(buffer);
+    free(strings);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  // all byte histograms are built in one pass
+  size_t histograms[8][256] = {{0}};
+
+  for (size_t i = 0; i < count; i++) {
+    records[i].prefix = poeGetKeyPrefix(text->strings + i, POE_KEY_ORDER_REVERSE);
+    records[i].index = i;
+
+    for (unsigned int digit = 0; digit < 8; digit++)
+      histograms[digit][(records[i].prefix >> digit * 8) & 0xFF]++;
+  }
+
+  // LSD passes from least significant byte
+  for (unsigned int digit = 0; digit < 8; digit++) {
+    size_t *const histogram = histograms[digit];
+
+    // all records have the same byte, so pass changes nothing
+    if (histogram[(records[0].prefix >> digit * 8) & 0xFF] == count)
+      continue;
+
+    size_t offset = 0;
+    for (size_t c = 0; c < 256; c++) {
+      const size_t size = histogram[c];
+
+      histogram[c] = offset;
+      offset += size;
+    }
+
+    for (size_t i = 0; i < count; i++)
+      buffer[histogram[(records[i].prefix >> digit * 8) & 0xFF]++] = records[i];
+
+    PoeRhymeRecord *tmp = records;
+    records = buffer;
+    buffer = tmp;
+  }
+
+  for (size_t i = 0; i < count; i++)
+    strings[i] = text->strings[records[i].index];
+
+  // strings with equal prefixes are ordered by full comparison
+  for (size_t runBegin = 0, runEnd = 0; runBegin < count; runBegin = runEnd) {
+    runEnd = runBegin + 1;
+
+    while (runEnd < count && records[runEnd].prefix == records[runBegin].prefix)
+      runEnd++;
+
+    // prefixes with zero last byte belong to keys shorter than 8 characters, so they're equal
+    if (runEnd - runBegin > 1 && (records[runBegin].prefix & 0xFF) != 0)
+      poeRhymeSortRun(strings + runBegin, runEnd - runBegin);
+  }
+
+  memcpy(text->strings, strings, count * sizeof(PoeString));
+
+  free(records);
+  free(buffer);
+  free(strings);
+
+  return POE_STATUS_OK;
+} // poeSortTextRhyme function end
+
+// poe_radix.cpp file end
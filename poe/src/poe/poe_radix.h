@@ -0,0 +1,50 @@
+/**
+ * @file   poe/poe_radix.h
+ * @author tiot2
+ * @brief  Poem processor string radix sort declaration module
+ */
+
+#ifndef POE_RADIX_H_
+#define POE_RADIX_H_
+
+#include "poe_key.h"
+
+/**
+ * @brief keyed records by multikey (3-way radix) quicksort sorting function
+ * 
+ * @param records     records to sort
+ * @param recordCount count of records
+ */
+void POE_API
+poeSortKeyedRecordsRadix( PoeKeyedRecord *records, size_t recordCount );
+
+/**
+ * @brief text by precomputed keys multikey quicksort sorting function
+ * 
+ * @param text  text to sort
+ * @param keys  keys of text (permuted with text strings, so they stay parallel to them)
+ * @param order sort order
+ * 
+ * @note ordering is the same as poeSortTextKeyed one, but strings with equal keys may go in different order
+ * 
+ * @return operation status (text and keys are not changed in case of failure)
+ */
+PoeStatus POE_API
+poeSortTextRadix( PoeText *text, PoeTextKeys *keys, PoeKeyOrder order );
+
+/**
+ * @brief text in rhyme (poeCompareFromEnd) order sorting function
+ * 
+ * @param text text to sort
+ * 
+ * @note LSD radix sort on 8-character reversed key prefixes, strings with equal
+ *       prefixes are ordered by the rest of their reversed keys then; keys are not required
+ * 
+ * @return operation status (text is not changed in case of failure)
+ */
+PoeStatus POE_API
+poeSortTextRhyme( PoeText *text );
+
+#endif // !defined(POE_RADIX_H_)
+
+// poe_radix.h file end
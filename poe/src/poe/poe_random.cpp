@@ -0,0 +1,73 @@
+/**
+ * @file   poe/poe_random.cpp
+ * @author tiot2
+ * @brief  Poem processor pseudo-random number generation implementation module
+ */
+
+#include <atomic>
+
+#include "poe_random.h"
+#include "poe_parallel.h"
+
+/// batch generation context representation structure
+typedef struct __PoeRandomBatchContext {
+  size_t             itemCount; ///< count of items to generate
+  uint64_t           seed;      ///< batch seed
+  PoeRandomBatchFn   itemFn;    ///< item generation function
+  void             * context;   ///< item generation function context
+  std::atomic<bool>  failed;    ///< some item generation failed flag
+} PoeRandomBatchContext;
+
+/**
+ * @brief batch block generation function
+ *
+ * @param context    batch context
+ * @param blockIndex index of block to generate
+ */
+static void POE_API
+poeRandomGenerateBlock( void *const context, const size_t blockIndex ) {
+  PoeRandomBatchContext *const batch = (PoeRandomBatchContext *)context;
+  const size_t begin = blockIndex * POE_RANDOM_BATCH_BLOCK_SIZE;
+  const size_t end = begin + POE_RANDOM_BATCH_BLOCK_SIZE < batch->itemCount
+    ? begin + POE_RANDOM_BATCH_BLOCK_SIZE
+    : batch->itemCount;
+  PoeRandom random;
+
+  poeRandomSeed(&random, batch->seed, blockIndex);
+
+  for (size_t i = begin; i < end; i++)
+    if (!batch->itemFn(batch->context, &random, i)) {
+      batch->failed.store(true, std::memory_order_relaxed);
+      return;
+    }
+} // poeRandomGenerateBlock function end
+
+PoeBool POE_API
+poeRandomGenerateBatch(
+  const size_t itemCount,
+  const uint64_t seed,
+  const size_t threadCount,
+  const PoeRandomBatchFn itemFn,
+  void *const context
+) {
+  assert(itemFn != NULL);
+
+  PoeRandomBatchContext batch;
+
+  batch.itemCount = itemCount;
+  batch.seed = seed;
+  batch.itemFn = itemFn;
+  batch.context = context;
+  batch.failed.store(false, std::memory_order_relaxed);
+
+  poeParallelFor(
+    (itemCount + POE_RANDOM_BATCH_BLOCK_SIZE - 1) / POE_RANDOM_BATCH_BLOCK_SIZE,
+    threadCount,
+    poeRandomGenerateBlock,
+    &batch
+  );
+
+  return !batch.failed.load(std::memory_order_relaxed);
+} // poeRandomGenerateBatch function end
+
+// poe_random.cpp file end
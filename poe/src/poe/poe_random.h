@@ -0,0 +1,132 @@
+/**
+ * @file   poe/poe_random.h
+ * @author tiot2
+ * @brief  Poem processor pseudo-random number generation declaration module
+ */
+
+#ifndef POE_RANDOM_H_
+#define POE_RANDOM_H_
+
+#include "poe_core.h"
+
+/// count of items generated from single random stream by poeRandomGenerateBatch
+#define POE_RANDOM_BATCH_BLOCK_SIZE 64
+
+/// xoshiro256** pseudo-random generator state representation structure
+typedef struct __PoeRandom {
+  uint64_t state[4]; ///< generator state (must not be all zero)
+} PoeRandom;
+
+/**
+ * @brief splitmix64 step function
+ *
+ * @param state splitmix state (input/output)
+ *
+ * @return pseudo-random number
+ */
+inline uint64_t POE_API
+poeRandomSplitMix( uint64_t *const state ) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+} // poeRandomSplitMix function end
+
+/**
+ * @brief random stream seeding function
+ *
+ * @param random random generator to seed
+ * @param seed   seed
+ * @param stream stream index (streams of same seed are independent)
+ */
+inline void POE_API
+poeRandomSeed( PoeRandom *const random, const uint64_t seed, const uint64_t stream ) {
+  // stream index is mixed in, so neighbour streams do not share splitmix sequence parts
+  uint64_t streamState = stream;
+  uint64_t state = seed ^ poeRandomSplitMix(&streamState);
+
+  for (size_t i = 0; i < 4; i++)
+    random->state[i] = poeRandomSplitMix(&state);
+} // poeRandomSeed function end
+
+/**
+ * @brief 64-bit pseudo-random number getting function
+ *
+ * @param random random generator
+ *
+ * @return pseudo-random number
+ */
+inline uint64_t POE_API
+poeRandomNext( PoeRandom *const random ) {
+  uint64_t *const s = random->state;
+  const uint64_t x = s[1] * 5;
+  const uint64_t result = ((x << 7) | (x >> 57)) * 9;
+  const uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = (s[3] << 45) | (s[3] >> 19);
+
+  return result;
+} // poeRandomNext function end
+
+/**
+ * @brief unbiased pseudo-random number in [0, bound) getting function
+ *
+ * @param random random generator
+ * @param bound  exclusive upper bound (non-zero)
+ *
+ * @return pseudo-random number
+ */
+inline uint32_t POE_API
+poeRandomBounded( PoeRandom *const random, const uint32_t bound ) {
+  assert(bound != 0);
+
+  // multiply-shift reduction with rejection of biased low products
+  uint64_t product = (poeRandomNext(random) >> 32) * bound;
+
+  if ((uint32_t)product < bound) {
+    const uint32_t threshold = (uint32_t)(0 - bound) % bound;
+
+    while ((uint32_t)product < threshold)
+      product = (poeRandomNext(random) >> 32) * bound;
+  }
+
+  return (uint32_t)(product >> 32);
+} // poeRandomBounded function end
+
+/**
+ * @brief batch item generation function pointer definition
+ *
+ * @param context   user context
+ * @param random    random stream to generate item by
+ * @param itemIndex index of item to generate
+ *
+ * @return POE_TRUE if generated, POE_FALSE otherwise
+ */
+typedef PoeBool (POE_API * PoeRandomBatchFn)( void *context, PoeRandom *random, size_t itemIndex );
+
+/**
+ * @brief reproducible parallel batch generation function
+ *
+ * @param itemCount   count of items to generate
+ * @param seed        batch seed
+ * @param threadCount count of threads (0 for hardware thread count)
+ * @param itemFn      item generation function
+ * @param context     item generation function context
+ *
+ * @note every POE_RANDOM_BATCH_BLOCK_SIZE items are generated in order from own stream
+ *       (seeded by seed and block index), so result does not depend on thread count
+ *
+ * @return POE_TRUE if all items are generated, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeRandomGenerateBatch( size_t itemCount, uint64_t seed, size_t threadCount, PoeRandomBatchFn itemFn, void *context );
+
+#endif // !defined(POE_RANDOM_H_)
+
+// poe_random.h file end
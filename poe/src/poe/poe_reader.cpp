@@ -0,0 +1,152 @@
+/**
+ * @file   poe/poe_reader.cpp
+ * @author tiot2
+ * @brief  Poem processor streaming text reader implementation module
+ */
+
+#include "poe_reader.h"
+#include "poe_arena.h"
+
+PoeStatus POE_API
+poeOpenTextReader( FILE *const file, size_t windowSize, size_t batchSize, PoeTextReader *const reader ) {
+  assert(file != NULL);
+  assert(reader != NULL);
+
+  if (windowSize == 0)
+    windowSize = POE_READER_DEFAULT_WINDOW_SIZE;
+  if (batchSize == 0)
+    batchSize = POE_READER_DEFAULT_BATCH_SIZE;
+
+  memset(reader, 0, sizeof(PoeTextReader));
+
+  // with ending \0
+  if ((reader->window = (char *)poeArenaAllocate(NULL, windowSize + 1)) == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  if ((reader->strings = (PoeString *)poeArenaAllocateZeroed(NULL, batchSize, sizeof(PoeString))) == NULL) {
+    free(reader->window);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  reader->file = file;
+  reader->windowCapacity = windowSize;
+  reader->batchSize = batchSize;
+
+  return POE_STATUS_OK;
+} // poeOpenTextReader function end
+
+/**
+ * @brief reader window refilling function
+ * 
+ * @param reader reader to refill window of
+ * 
+ * @note invalidates all strings yielded before
+ * 
+ * @return operation status
+ */
+static PoeStatus
+poeTextReaderFill( PoeTextReader *const reader ) {
+  // move not yielded data to window start
+  const size_t tailSize = reader->windowSize - reader->windowOffset;
+
+  memmove(reader->window, reader->window + reader->windowOffset, tailSize);
+  reader->windowSize = tailSize;
+  reader->windowOffset = 0;
+
+  // tail occupies all window, so line is longer than window
+  if (tailSize == reader->windowCapacity) {
+    const size_t capacity = reader->windowCapacity * 2;
+    char *window = (char *)poeArenaReallocate(NULL, reader->window, reader->windowCapacity + 1, capacity + 1);
+
+    if (window == NULL)
+      return POE_STATUS_BAD_ALLOC;
+
+    reader->window = window;
+    reader->windowCapacity = capacity;
+  }
+
+  char *const data = reader->window + reader->windowSize;
+  const size_t readSize = fread(data, 1, reader->windowCapacity - reader->windowSize, reader->file);
+
+  if (readSize == 0) {
+    if (ferror(reader->file))
+      return POE_STATUS_IO_ERROR;
+    reader->endOfFile = POE_TRUE;
+  }
+
+  // remove '\r' characters from read data
+  char *writer = data;
+
+  if (memchr(data, '\r', readSize) != NULL) {
+    for (const char *iter = data, *const end = data + readSize; iter < end; iter++)
+      if (*iter != '\r')
+        *writer++ = *iter;
+  } else {
+    writer = data + readSize;
+  }
+
+  reader->windowSize = writer - reader->window;
+
+  return POE_STATUS_OK;
+} // poeTextReaderFill function end
+
+PoeStatus POE_API
+poeTextReaderNext( PoeTextReader *const reader, PoeText *const batch ) {
+  assert(reader != NULL);
+  assert(batch != NULL);
+
+  memset(batch, 0, sizeof(PoeText));
+  batch->strings = reader->strings;
+
+  size_t stringCount = 0;
+
+  while (!reader->finished && stringCount < reader->batchSize) {
+    char *const lineBegin = reader->window + reader->windowOffset;
+    char *const windowEnd = reader->window + reader->windowSize;
+    char *const lineEnd = (char *)memchr(lineBegin, '\n', windowEnd - lineBegin);
+
+    if (lineEnd != NULL) {
+      *lineEnd = '\0';
+      reader->strings[stringCount].begin = lineBegin;
+      reader->strings[stringCount].end = lineEnd;
+      stringCount++;
+
+      reader->windowOffset = lineEnd + 1 - reader->window;
+      continue;
+    }
+
+    // last string has no '\n' after it
+    if (reader->endOfFile) {
+      *windowEnd = '\0';
+      reader->strings[stringCount].begin = lineBegin;
+      reader->strings[stringCount].end = windowEnd;
+      stringCount++;
+
+      reader->windowOffset = reader->windowSize;
+      reader->finished = POE_TRUE;
+      break;
+    }
+
+    // window refill invalidates strings, so current batch should be yielded first
+    if (stringCount != 0)
+      break;
+
+    PoeStatus status = poeTextReaderFill(reader);
+    if (!POE_CHECK(status))
+      return status;
+  }
+
+  batch->stringCount = stringCount;
+
+  return POE_STATUS_OK;
+} // poeTextReaderNext function end
+
+void POE_API
+poeCloseTextReader( PoeTextReader *const reader ) {
+  assert(reader != NULL);
+
+  free(reader->window);
+  free(reader->strings);
+} // poeCloseTextReader function end
+
+// poe_reader.cpp file end
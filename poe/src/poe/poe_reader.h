@@ -0,0 +1,68 @@
+/**
+ * @file   poe/poe_reader.h
+ * @author tiot2
+ * @brief  Poem processor streaming text reader declaration module
+ */
+
+#ifndef POE_READER_H_
+#define POE_READER_H_
+
+#include "poe_core.h"
+
+/// default reader window size
+#define POE_READER_DEFAULT_WINDOW_SIZE ((size_t)1 << 20)
+
+/// default reader batch size
+#define POE_READER_DEFAULT_BATCH_SIZE ((size_t)1 << 14)
+
+/// streaming text reader representation structure
+typedef struct __PoeTextReader {
+  FILE      * file;           ///< file to read text from
+  char      * window;         ///< window buffer
+  size_t      windowCapacity; ///< window buffer capacity (without terminating '\0')
+  size_t      windowSize;     ///< count of valid bytes in window
+  size_t      windowOffset;   ///< offset of first not yet yielded byte in window
+  PoeString * strings;        ///< batch strings
+  size_t      batchSize;      ///< maximal count of strings in batch
+  PoeBool     endOfFile;      ///< file is read completely
+  PoeBool     finished;       ///< last string is yielded
+} PoeTextReader;
+
+/**
+ * @brief streaming text reader open function
+ * 
+ * @param file       file to read text from (must be opened in binary mode)
+ * @param windowSize initial window size (0 for POE_READER_DEFAULT_WINDOW_SIZE), window grows for longer lines only
+ * @param batchSize  maximal count of strings in batch (0 for POE_READER_DEFAULT_BATCH_SIZE)
+ * @param reader     reader to open
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeOpenTextReader( FILE *file, size_t windowSize, size_t batchSize, PoeTextReader *reader );
+
+/**
+ * @brief next string batch reading function
+ * 
+ * @param reader reader to read batch from
+ * @param batch  batch destination (stringCount is 0 if text is over)
+ * 
+ * @note batch strings refer to reader window and are valid until next poeTextReaderNext call;
+ *       batch must not be destroyed by poeDestroyText. Strings are split same way as poeParseText does.
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeTextReaderNext( PoeTextReader *reader, PoeText *batch );
+
+/**
+ * @brief streaming text reader close function
+ * 
+ * @param reader reader to close (file is not closed)
+ */
+void POE_API
+poeCloseTextReader( PoeTextReader *reader );
+
+#endif // !defined(POE_READER_H_)
+
+// poe_reader.h file end
@@ -0,0 +1,531 @@
+/**
+ * @file   poe/poe_scan.cpp
+ * @author tiot2
+ * @brief  Poem processor text line scanning implementation module
+ */
+
+#include "poe_scan.h"
+#include "poe_arena.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define POE_SCAN_X86
+#endif
+
+#ifdef POE_SCAN_X86
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+// MSVC allows any intrinsics without target-specific compilation flags
+#define POE_SCAN_TARGET_SSE2
+#define POE_SCAN_TARGET_AVX2
+#else
+#define POE_SCAN_TARGET_SSE2 __attribute__((target("sse2")))
+#define POE_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif // defined(POE_SCAN_X86)
+
+/// scanning state representation structure
+typedef struct __PoeScanState {
+  char      * writer;         ///< destination writer
+  PoeString * strings;        ///< string array
+  size_t      stringCount;    ///< count of finished strings
+  size_t      stringCapacity; ///< string array capacity
+  PoeArena  * arena;          ///< arena string array is allocated from (NULL for heap)
+} PoeScanState;
+
+/// scanning kernel function pointer
+typedef PoeBool (* PoeScanKernelFn)( PoeScanState *state, const char *src, size_t size );
+
+/**
+ * @brief string array growing function
+ * 
+ * @param state scanning state
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static PoeBool
+poeScanGrow( PoeScanState *const state ) {
+  size_t capacity = state->stringCapacity * 2;
+  PoeString *strings = (PoeString *)poeArenaReallocate(state->arena, state->strings, state->stringCapacity * sizeof(PoeString), capacity * sizeof(PoeString));
+
+  if (strings == NULL)
+    return POE_FALSE;
+
+  state->strings = strings;
+  state->stringCapacity = capacity;
+
+  return POE_TRUE;
+} // poeScanGrow function end
+
+/**
+ * @brief line ending function
+ * 
+ * @param state   scanning state
+ * @param lineEnd line end (written '\0' character) pointer
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static inline PoeBool
+poeScanEndLine( PoeScanState *const state, char *const lineEnd ) {
+  // finished string and beginning of next one
+  if (state->stringCount + 2 > state->stringCapacity && !poeScanGrow(state))
+    return POE_FALSE;
+
+  state->strings[state->stringCount].end = lineEnd;
+  state->strings[state->stringCount + 1].begin = lineEnd + 1;
+  state->stringCount++;
+
+  return POE_TRUE;
+} // poeScanEndLine function end
+
+/**
+ * @brief scalar scanning kernel
+ * 
+ * @param state scanning state
+ * @param src   text data
+ * @param size  text data size
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static PoeBool
+poeScanKernelScalar( PoeScanState *const state, const char *const src, const size_t size ) {
+  char *writer = state->writer;
+
+  for (const char *reader = src, *const readerEnd = src + size; reader < readerEnd; reader++) {
+    const char c = *reader;
+
+    if (c == '\r')
+      continue;
+
+    if (c == '\n') {
+      *writer = '\0';
+
+      if (!poeScanEndLine(state, writer))
+        return POE_FALSE;
+    } else {
+      *writer = c;
+    }
+    writer++;
+  }
+
+  state->writer = writer;
+  return POE_TRUE;
+} // poeScanKernelScalar function end
+
+#ifdef POE_SCAN_X86
+
+/**
+ * @brief count of trailing zero bits getting function
+ * 
+ * @param mask non-zero mask
+ * 
+ * @return count of trailing zero bits
+ */
+static inline unsigned int
+poeScanCountTrailingZeros( const uint64_t mask ) {
+#ifdef _MSC_VER
+  unsigned long index;
+
+#ifdef _M_X64
+  _BitScanForward64(&index, mask);
+#else
+  if ((uint32_t)mask != 0)
+    _BitScanForward(&index, (uint32_t)mask);
+  else {
+    _BitScanForward(&index, (uint32_t)(mask >> 32));
+    index += 32;
+  }
+#endif
+  return (unsigned int)index;
+#else
+  return (unsigned int)__builtin_ctzll(mask);
+#endif
+} // poeScanCountTrailingZeros function end
+
+/**
+ * @brief block line ends emitting function
+ * 
+ * @param state      scanning state
+ * @param blockBegin block begin in destination
+ * @param lineMask   newline position mask
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static inline PoeBool
+poeScanEmitLineMask( PoeScanState *const state, char *const blockBegin, uint64_t lineMask ) {
+  while (lineMask != 0) {
+    if (!poeScanEndLine(state, blockBegin + poeScanCountTrailingZeros(lineMask)))
+      return POE_FALSE;
+    lineMask &= lineMask - 1;
+  }
+
+  return POE_TRUE;
+} // poeScanEmitLineMask function end
+
+/// 8-byte group '\r' removal table representation structure
+typedef struct __PoeScanGroupTable {
+  uint64_t      shuffles[256];   ///< byte shuffle that packs bytes except '\r' ones to group start (indexed by group '\r' position mask)
+  unsigned char keptCounts[256]; ///< count of bytes except '\r' ones (indexed by group '\r' position mask)
+} PoeScanGroupTable;
+
+/**
+ * @brief group '\r' removal table building function
+ * 
+ * @return table
+ */
+static constexpr PoeScanGroupTable
+poeScanBuildGroupTable( void ) {
+  PoeScanGroupTable table = {};
+
+  for (unsigned int crMask = 0; crMask < 256; crMask++) {
+    unsigned int keptCount = 0;
+
+    // shuffle control byte with high bit set gives zero byte
+    table.shuffles[crMask] = ~(uint64_t)0;
+    for (unsigned int i = 0; i < 8; i++) {
+      if ((crMask >> i & 1) != 0)
+        continue;
+      table.shuffles[crMask] &= ~((uint64_t)0xFF << keptCount * 8);
+      table.shuffles[crMask] |= (uint64_t)i << keptCount * 8;
+      keptCount++;
+    }
+    table.keptCounts[crMask] = (unsigned char)keptCount;
+  }
+
+  return table;
+} // poeScanBuildGroupTable function end
+
+/// group '\r' removal table
+static constexpr PoeScanGroupTable poeScanGroupTable = poeScanBuildGroupTable();
+
+/**
+ * @brief compressed group line ends emitting function
+ * 
+ * @param state         scanning state
+ * @param groupBegin    group begin in destination (after '\r' removal)
+ * @param groupLineMask group newline position mask
+ * @param groupCrMask   group '\r' position mask
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static inline PoeBool
+poeScanEmitGroupLines( PoeScanState *const state, char *const groupBegin, unsigned int groupLineMask, const unsigned int groupCrMask ) {
+  while (groupLineMask != 0) {
+    const unsigned int index = poeScanCountTrailingZeros(groupLineMask);
+
+    // line end is moved back by count of '\r' characters before it
+    if (!poeScanEndLine(state, groupBegin + poeScanGroupTable.keptCounts[groupCrMask & ((1u << index) - 1)] - 8 + index))
+      return POE_FALSE;
+    groupLineMask &= groupLineMask - 1;
+  }
+
+  return POE_TRUE;
+} // poeScanEmitGroupLines function end
+
+/**
+ * @brief stored block '\r' removal and line ends emitting function (SSE2 version)
+ * 
+ * @param state     scanning state (writer points to stored block)
+ * @param blockSize stored block size (multiple of 8, at most 64)
+ * @param lineMask  newline position mask
+ * @param crMask    '\r' position mask
+ * 
+ * @note block is compressed in place by 8-byte groups, every group is stored right after previous
+ *       one. Store never reaches next group, so every group is read before it is overwritten. SSE2
+ *       has no byte shuffle, so '\r' bytes are cut out of group loaded as 64-bit integer (x86 is
+ *       little-endian, so integer bytes go in memory order)
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+static inline PoeBool
+poeScanCompressBlockSse2( PoeScanState *const state, const size_t blockSize, const uint64_t lineMask, const uint64_t crMask ) {
+  const char *const block = state->writer;
+  char *writer = state->writer;
+
+  for (size_t group = 0; group < blockSize; group += 8) {
+    const unsigned int groupCrMask = (unsigned int)(crMask >> group) & 0xFF;
+    const unsigned int groupLineMask = (unsigned int)(lineMask >> group) & 0xFF;
+    uint64_t data;
+
+    memcpy(&data, block + group, 8);
+
+    for (unsigned int rest = groupCrMask, removedCount = 0; rest != 0; rest &= rest - 1, removedCount++) {
+      const unsigned int shift = (poeScanCountTrailingZeros(rest) - removedCount) * 8;
+
+      data = (data & (((uint64_t)1 << shift) - 1)) | (data >> 8 >> shift << shift);
+    }
+
+    memcpy(writer, &data, 8);
+
+    if (groupLineMask != 0 && !poeScanEmitGroupLines(state, writer, groupLineMask, groupCrMask))
+      return POE_FALSE;
+    writer += poeScanGroupTable.keptCounts[groupCrMask];
+  }
+
+  state->writer = writer;
+  return POE_TRUE;
+} // poeScanCompressBlockSse2 function end
+
+/**
+ * @brief stored block '\r' removal and line ends emitting function (AVX2 version)
+ * 
+ * @param state     scanning state (writer points to stored block)
+ * @param blockSize stored block size (multiple of 8, at most 64)
+ * @param lineMask  newline position mask
+ * @param crMask    '\r' position mask
+ * 
+ * @note block is compressed in place by 8-byte groups as by poeScanCompressBlockSse2, but groups
+ *       are packed by table byte shuffle without branches
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+POE_SCAN_TARGET_AVX2 static inline PoeBool
+poeScanCompressBlockAvx2( PoeScanState *const state, const size_t blockSize, const uint64_t lineMask, const uint64_t crMask ) {
+  const char *const block = state->writer;
+  char *writer = state->writer;
+
+  for (size_t group = 0; group < blockSize; group += 8) {
+    const unsigned int groupCrMask = (unsigned int)(crMask >> group) & 0xFF;
+    const unsigned int groupLineMask = (unsigned int)(lineMask >> group) & 0xFF;
+    const __m128i data = _mm_loadl_epi64((const __m128i *)(block + group));
+    const __m128i shuffle = _mm_loadl_epi64((const __m128i *)(poeScanGroupTable.shuffles + groupCrMask));
+
+    _mm_storel_epi64((__m128i *)writer, _mm_shuffle_epi8(data, shuffle));
+
+    if (groupLineMask != 0 && !poeScanEmitGroupLines(state, writer, groupLineMask, groupCrMask))
+      return POE_FALSE;
+    writer += poeScanGroupTable.keptCounts[groupCrMask];
+  }
+
+  state->writer = writer;
+  return POE_TRUE;
+} // poeScanCompressBlockAvx2 function end
+
+/**
+ * @brief SSE2 scanning kernel
+ * 
+ * @param state scanning state
+ * @param src   text data
+ * @param size  text data size
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+POE_SCAN_TARGET_SSE2 static PoeBool
+poeScanKernelSse2( PoeScanState *const state, const char *const src, const size_t size ) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i carriageReturn = _mm_set1_epi8('\r');
+  size_t offset = 0;
+
+  for (; offset + 32 <= size; offset += 32) {
+    // both blocks are loaded before any store, as destination may overlap source
+    const __m128i v0 = _mm_loadu_si128((const __m128i *)(src + offset));
+    const __m128i v1 = _mm_loadu_si128((const __m128i *)(src + offset + 16));
+
+    const __m128i n0 = _mm_cmpeq_epi8(v0, newline);
+    const __m128i n1 = _mm_cmpeq_epi8(v1, newline);
+    const uint32_t crMask =
+      (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v0, carriageReturn)) |
+      (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v1, carriageReturn)) << 16;
+    const uint32_t lineMask = (uint32_t)_mm_movemask_epi8(n0) | (uint32_t)_mm_movemask_epi8(n1) << 16;
+    char *const writer = state->writer;
+
+    _mm_storeu_si128((__m128i *)writer, _mm_andnot_si128(n0, v0));
+    _mm_storeu_si128((__m128i *)(writer + 16), _mm_andnot_si128(n1, v1));
+
+    if (crMask != 0) {
+      if (!poeScanCompressBlockSse2(state, 32, lineMask, crMask))
+        return POE_FALSE;
+      continue;
+    }
+
+    state->writer += 32;
+
+    if (lineMask != 0 && !poeScanEmitLineMask(state, writer, lineMask))
+      return POE_FALSE;
+  }
+
+  return poeScanKernelScalar(state, src + offset, size - offset);
+} // poeScanKernelSse2 function end
+
+/**
+ * @brief AVX2 scanning kernel
+ * 
+ * @param state scanning state
+ * @param src   text data
+ * @param size  text data size
+ * 
+ * @return POE_TRUE if succeeded, POE_FALSE otherwise
+ */
+POE_SCAN_TARGET_AVX2 static PoeBool
+poeScanKernelAvx2( PoeScanState *const state, const char *const src, const size_t size ) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i carriageReturn = _mm256_set1_epi8('\r');
+  size_t offset = 0;
+
+  for (; offset + 64 <= size; offset += 64) {
+    // both blocks are loaded before any store, as destination may overlap source
+    const __m256i v0 = _mm256_loadu_si256((const __m256i *)(src + offset));
+    const __m256i v1 = _mm256_loadu_si256((const __m256i *)(src + offset + 32));
+
+    const __m256i n0 = _mm256_cmpeq_epi8(v0, newline);
+    const __m256i n1 = _mm256_cmpeq_epi8(v1, newline);
+    const uint64_t crMask =
+      (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v0, carriageReturn)) |
+      (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, carriageReturn)) << 32;
+    const uint64_t lineMask =
+      (uint64_t)(uint32_t)_mm256_movemask_epi8(n0) |
+      (uint64_t)(uint32_t)_mm256_movemask_epi8(n1) << 32;
+    char *const writer = state->writer;
+
+    _mm256_storeu_si256((__m256i *)writer, _mm256_andnot_si256(n0, v0));
+    _mm256_storeu_si256((__m256i *)(writer + 32), _mm256_andnot_si256(n1, v1));
+
+    if (crMask != 0) {
+      if (!poeScanCompressBlockAvx2(state, 64, lineMask, crMask))
+        return POE_FALSE;
+      continue;
+    }
+
+    state->writer += 64;
+
+    if (lineMask != 0 && !poeScanEmitLineMask(state, writer, lineMask))
+      return POE_FALSE;
+  }
+
+  return poeScanKernelScalar(state, src + offset, size - offset);
+} // poeScanKernelAvx2 function end
+
+#endif // defined(POE_SCAN_X86)
+
+PoeBool POE_API
+poeScanIsKernelSupported( const PoeScanKernel kernel ) {
+  switch (kernel) {
+  case POE_SCAN_KERNEL_AUTO   :
+  case POE_SCAN_KERNEL_SCALAR :
+    return POE_TRUE;
+
+#ifdef POE_SCAN_X86
+#ifdef _MSC_VER
+  case POE_SCAN_KERNEL_SSE2   : {
+    int info[4] = {0};
+
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+  }
+
+  case POE_SCAN_KERNEL_AVX2   : {
+    int info[4] = {0};
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+      return POE_FALSE;
+
+    // AVX and OS-enabled YMM state
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+      return POE_FALSE;
+    if ((_xgetbv(0) & 6) != 6)
+      return POE_FALSE;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+  }
+#else
+  case POE_SCAN_KERNEL_SSE2   :
+    return __builtin_cpu_supports("sse2");
+
+  case POE_SCAN_KERNEL_AVX2   :
+    return __builtin_cpu_supports("avx2");
+#endif
+#endif // defined(POE_SCAN_X86)
+
+  default:
+    return POE_FALSE;
+  }
+} // poeScanIsKernelSupported function end
+
+const char * POE_API
+poeScanGetKernelName( const PoeScanKernel kernel ) {
+  switch (kernel) {
+  case POE_SCAN_KERNEL_AUTO   : return "auto";
+  case POE_SCAN_KERNEL_SCALAR : return "scalar";
+  case POE_SCAN_KERNEL_SSE2   : return "sse2";
+  case POE_SCAN_KERNEL_AVX2   : return "avx2";
+  }
+
+  return "unknown";
+} // poeScanGetKernelName function end
+
+/// currently selected kernel (POE_SCAN_KERNEL_AUTO if not resolved yet)
+static PoeScanKernel poeScanCurrentKernel = POE_SCAN_KERNEL_AUTO;
+
+void POE_API
+poeScanSetKernel( const PoeScanKernel kernel ) {
+  poeScanCurrentKernel = poeScanIsKernelSupported(kernel) ? kernel : POE_SCAN_KERNEL_AUTO;
+} // poeScanSetKernel function end
+
+PoeScanKernel POE_API
+poeScanGetKernel( void ) {
+  if (poeScanCurrentKernel == POE_SCAN_KERNEL_AUTO) {
+    if (poeScanIsKernelSupported(POE_SCAN_KERNEL_AVX2))
+      poeScanCurrentKernel = POE_SCAN_KERNEL_AVX2;
+    else if (poeScanIsKernelSupported(POE_SCAN_KERNEL_SSE2))
+      poeScanCurrentKernel = POE_SCAN_KERNEL_SSE2;
+    else
+      poeScanCurrentKernel = POE_SCAN_KERNEL_SCALAR;
+  }
+
+  return poeScanCurrentKernel;
+} // poeScanGetKernel function end
+
+PoeStatus POE_API
+poeScanLines( char *const dst, const char *const src, const size_t size, PoeScanResult *const result, PoeArena *const arena ) {
+  assert(dst != NULL);
+  assert(src != NULL || size == 0);
+  assert(result != NULL);
+
+  PoeScanState state = {
+    .writer = dst,
+    .strings = NULL,
+    .stringCount = 0,
+    // assume average line of 32 characters
+    .stringCapacity = size / 32 + 2,
+    .arena = arena,
+  };
+
+  if ((state.strings = (PoeString *)poeArenaAllocate(arena, state.stringCapacity * sizeof(PoeString))) == NULL)
+    return POE_STATUS_BAD_ALLOC;
+  state.strings[0].begin = dst;
+
+  PoeScanKernelFn kernelFn = poeScanKernelScalar;
+
+#ifdef POE_SCAN_X86
+  switch (poeScanGetKernel()) {
+  case POE_SCAN_KERNEL_SSE2 : kernelFn = poeScanKernelSse2; break;
+  case POE_SCAN_KERNEL_AVX2 : kernelFn = poeScanKernelAvx2; break;
+  default                   : break;
+  }
+#endif
+
+  if (size != 0 && !kernelFn(&state, src, size)) {
+    poeArenaFree(arena, state.strings);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  state.strings[state.stringCount++].end = state.writer;
+
+  // truncate capacity (gives memory back to arena if nothing was allocated from it since), failure is not critical there
+  PoeString *strings = (PoeString *)poeArenaReallocate(arena, state.strings, state.stringCapacity * sizeof(PoeString), state.stringCount * sizeof(PoeString));
+  if (strings != NULL)
+    state.strings = strings;
+
+  result->strings = state.strings;
+  result->stringCount = state.stringCount;
+  result->size = (size_t)(state.writer - dst);
+
+  return POE_STATUS_OK;
+} // poeScanLines function end
+
+// poe_scan.cpp file end
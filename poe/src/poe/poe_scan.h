@@ -0,0 +1,82 @@
+/**
+ * @file   poe/poe_scan.h
+ * @author tiot2
+ * @brief  Poem processor text line scanning declaration module
+ */
+
+#ifndef POE_SCAN_H_
+#define POE_SCAN_H_
+
+#include "poe_core.h"
+
+/// line scanning kernel
+typedef enum __PoeScanKernel {
+  POE_SCAN_KERNEL_AUTO   = 0, ///< best kernel supported by CPU
+  POE_SCAN_KERNEL_SCALAR = 1, ///< byte-by-byte kernel
+  POE_SCAN_KERNEL_SSE2   = 2, ///< 32 bytes per iteration SSE2 kernel
+  POE_SCAN_KERNEL_AVX2   = 3, ///< 64 bytes per iteration AVX2 kernel
+} PoeScanKernel;
+
+/// line scanning result representation structure
+typedef struct __PoeScanResult {
+  PoeString * strings;     ///< scanned lines (must be freed by poeArenaFree with arena they were scanned with)
+  size_t      stringCount; ///< count of scanned lines
+  size_t      size;        ///< count of bytes written to destination
+} PoeScanResult;
+
+/**
+ * @brief text lines scanning function
+ * 
+ * @param dst    destination buffer (at least size bytes, may be equal to src)
+ * @param src    text data
+ * @param size   text data size
+ * @param result scanning result
+ * @param arena  arena to allocate result strings from (NULL for heap)
+ * 
+ * @note copies text to dst in one pass, dropping '\r' and replacing '\n' by '\0';
+ *       result strings refer to dst
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeScanLines( char *dst, const char *src, size_t size, PoeScanResult *result, PoeArena *arena );
+
+/**
+ * @brief scanning kernel setting function
+ * 
+ * @param kernel kernel to use (unsupported kernels are replaced with POE_SCAN_KERNEL_AUTO)
+ */
+void POE_API
+poeScanSetKernel( PoeScanKernel kernel );
+
+/**
+ * @brief currently used scanning kernel getting function
+ * 
+ * @return kernel (never POE_SCAN_KERNEL_AUTO)
+ */
+PoeScanKernel POE_API
+poeScanGetKernel( void );
+
+/**
+ * @brief scanning kernel support by CPU checking function
+ * 
+ * @param kernel kernel to check
+ * 
+ * @return POE_TRUE if supported, POE_FALSE otherwise
+ */
+PoeBool POE_API
+poeScanIsKernelSupported( PoeScanKernel kernel );
+
+/**
+ * @brief scanning kernel name getting function
+ * 
+ * @param kernel kernel to get name of
+ * 
+ * @return kernel name
+ */
+const char * POE_API
+poeScanGetKernelName( PoeScanKernel kernel );
+
+#endif // !defined(POE_SCAN_H_)
+
+// poe_scan.h file end
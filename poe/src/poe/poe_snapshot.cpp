@@ -0,0 +1,398 @@
+/**
+ * @file   poe/poe_snapshot.cpp
+ * @author tiot2
+ * @brief  Poem processor generator snapshot implementation module
+ */
+
+#include "poe.h"
+#include "poe_snapshot.h"
+
+static_assert(sizeof(PoeSnapshotHeader) == 56, "snapshot header layout must not depend on compiler");
+static_assert(sizeof(PoeEnding) == 12, "snapshot ending layout must not depend on compiler");
+static_assert(sizeof(PoeOneginStringPair) == 8, "snapshot string pair layout must not depend on compiler");
+
+/**
+ * @brief text total string length getting function
+ *
+ * @param text text to get length of
+ *
+ * @return sum of text string lengths
+ */
+static uint64_t
+poeSnapshotGetTextLength( const PoeText *const text ) {
+  uint64_t length = 0;
+
+  for (size_t i = 0; i < text->stringCount; i++)
+    length += text->strings[i].end - text->strings[i].begin;
+
+  return length;
+} // poeSnapshotGetTextLength function end
+
+/// FNV-1a 64-bit hash offset basis
+#define POE_SNAPSHOT_HASH_BASIS 0xCBF29CE484222325ULL
+
+/// FNV-1a 64-bit hash prime
+#define POE_SNAPSHOT_HASH_PRIME 0x100000001B3ULL
+
+/**
+ * @brief string to text hash adding function
+ *
+ * @param hash   hash of previous strings
+ * @param string string to add
+ *
+ * @note string length is hashed too, so hash depends on string boundaries
+ *
+ * @return hash of previous strings and string
+ */
+static uint64_t
+poeSnapshotHashString( uint64_t hash, const PoeString string ) {
+  for (const char *c = string.begin; c < string.end; c++)
+    hash = (hash ^ (unsigned char)*c) * POE_SNAPSHOT_HASH_PRIME;
+
+  return (hash ^ (uint64_t)(string.end - string.begin)) * POE_SNAPSHOT_HASH_PRIME;
+} // poeSnapshotHashString function end
+
+/**
+ * @brief text strings in text order hashing function
+ *
+ * @param text text to hash
+ *
+ * @return text hash
+ */
+static uint64_t
+poeSnapshotHashText( const PoeText *const text ) {
+  uint64_t hash = POE_SNAPSHOT_HASH_BASIS;
+
+  for (size_t i = 0; i < text->stringCount; i++)
+    hash = poeSnapshotHashString(hash, text->strings[i]);
+
+  return hash;
+} // poeSnapshotHashText function end
+
+/**
+ * @brief compact text strings in initial order hashing function
+ *
+ * @param text compact text to hash
+ *
+ * @return text hash (same as poeSnapshotHashText of text in initial order)
+ */
+static uint64_t
+poeSnapshotHashCompactText( const PoeCompactText *const text ) {
+  uint64_t hash = POE_SNAPSHOT_HASH_BASIS;
+
+  for (size_t i = 0; i < text->stringCount; i++)
+    hash = poeSnapshotHashString(hash, poeCompactGetString(text, (uint32_t)i));
+
+  return hash;
+} // poeSnapshotHashCompactText function end
+
+/**
+ * @brief snapshot header initialization function
+ *
+ * @param header      header to initialize
+ * @param kind        snapshot kind
+ * @param text        text snapshot is made for
+ * @param textHash    hash of text strings in order snapshot indices refer to
+ * @param recordCount count of kind-specific records
+ * @param indexCount  count of string indices
+ */
+static void
+poeSnapshotInitHeader(
+  PoeSnapshotHeader *const header,
+  const PoeSnapshotKind kind,
+  const PoeText *const text,
+  const uint64_t textHash,
+  const size_t recordCount,
+  const size_t indexCount
+) {
+  memset(header, 0, sizeof(PoeSnapshotHeader));
+  memcpy(header->magic, POE_SNAPSHOT_MAGIC, sizeof(POE_SNAPSHOT_MAGIC));
+  header->version = POE_SNAPSHOT_VERSION;
+  header->kind = kind;
+  header->stringCount = text->stringCount;
+  header->textLength = poeSnapshotGetTextLength(text);
+  header->textHash = textHash;
+  header->recordCount = recordCount;
+  header->indexCount = indexCount;
+} // poeSnapshotInitHeader function end
+
+/**
+ * @brief snapshot file writing function
+ *
+ * @param fileName   snapshot file name
+ * @param header     snapshot header
+ * @param records    kind-specific records (may be NULL if there are none)
+ * @param recordSize size of single record (0 if there are no records)
+ * @param indices    string indices (header->indexCount elements, may be NULL if there are none)
+ *
+ * @return operation status
+ */
+static PoeStatus
+poeSnapshotWrite(
+  const char *const fileName,
+  const PoeSnapshotHeader *const header,
+  const void *const records,
+  const size_t recordSize,
+  const uint32_t *const indices
+) {
+  FILE *file = NULL;
+
+  if (fopen_s(&file, fileName, "wb") != 0 || file == NULL)
+    return POE_STATUS_IO_ERROR;
+
+  const size_t recordCount = recordSize == 0 ? 0 : (size_t)header->recordCount;
+  PoeBool ok =
+    fwrite(header, sizeof(PoeSnapshotHeader), 1, file) == 1 &&
+    (recordCount == 0 || fwrite(records, recordSize, recordCount, file) == recordCount) &&
+    (header->indexCount == 0 || fwrite(indices, sizeof(uint32_t), (size_t)header->indexCount, file) == header->indexCount);
+
+  ok = fclose(file) == 0 && ok;
+
+  return ok ? POE_STATUS_OK : POE_STATUS_IO_ERROR;
+} // poeSnapshotWrite function end
+
+/**
+ * @brief snapshot file mapping and validation function
+ *
+ * @param fileName   snapshot file name
+ * @param kind       expected snapshot kind
+ * @param text       text snapshot must be made for
+ * @param textHash   hash of text strings in order snapshot indices refer to
+ * @param recordSize size of single kind-specific record (0 if there are no records)
+ * @param mapping    snapshot mapping (output, must be unmapped if succeeded)
+ *
+ * @return operation status
+ */
+static PoeStatus
+poeSnapshotMap(
+  const char *const fileName,
+  const PoeSnapshotKind kind,
+  const PoeText *const text,
+  const uint64_t textHash,
+  const size_t recordSize,
+  PoeFileMapping *const mapping
+) {
+  if (!poeMapFile(fileName, mapping))
+    return POE_STATUS_IO_ERROR;
+
+  const PoeSnapshotHeader *const header = (const PoeSnapshotHeader *)mapping->data;
+  PoeBool ok =
+    mapping->size >= sizeof(PoeSnapshotHeader) &&
+    memcmp(header->magic, POE_SNAPSHOT_MAGIC, sizeof(POE_SNAPSHOT_MAGIC)) == 0 &&
+    header->version == POE_SNAPSHOT_VERSION &&
+    header->kind == (uint32_t)kind &&
+    header->stringCount == text->stringCount &&
+    header->recordCount <= mapping->size &&
+    header->indexCount <= mapping->size;
+
+  // table sizes are checked after header fields are known to be sane
+  ok = ok &&
+    mapping->size == sizeof(PoeSnapshotHeader) + header->recordCount * recordSize + header->indexCount * sizeof(uint32_t) &&
+    header->textLength == poeSnapshotGetTextLength(text) &&
+    header->textHash == textHash;
+
+  if (!ok) {
+    poeUnmapFile(mapping);
+    return POE_STATUS_BAD_FORMAT;
+  }
+
+  return POE_STATUS_OK;
+} // poeSnapshotMap function end
+
+PoeStatus POE_API
+poeSaveOneginGenerator( const PoeOneginGenerator *const generator, const char *const fileName ) {
+  assert(generator != NULL);
+  assert(generator->text != NULL);
+  assert(fileName != NULL);
+
+  const size_t bucketSize = generator->buckets[0].stringPairCount;
+  const size_t pairCount = bucketSize * POE_ONEGIN_BUCKET_COUNT;
+  PoeSnapshotHeader header;
+
+  poeSnapshotInitHeader(
+    &header,
+    POE_SNAPSHOT_KIND_ONEGIN_GENERATOR,
+    generator->text,
+    poeSnapshotHashCompactText(&generator->lines),
+    pairCount,
+    0
+  );
+
+  // buckets are laid out one after another unless they have spare space after append, so pairs are written at once
+  if (generator->stringPairCapacity == bucketSize)
+    return poeSnapshotWrite(fileName, &header, generator->buckets[0].stringPairSet, sizeof(PoeOneginStringPair), NULL);
+
+  PoeOneginStringPair *const pairs = (PoeOneginStringPair *)poeArenaAllocate(NULL, pairCount * sizeof(PoeOneginStringPair) + 1);
+
+  if (pairs == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  for (size_t i = 0; i < POE_ONEGIN_BUCKET_COUNT; i++)
+    memcpy(pairs + bucketSize * i, generator->buckets[i].stringPairSet, bucketSize * sizeof(PoeOneginStringPair));
+
+  const PoeStatus status = poeSnapshotWrite(fileName, &header, pairs, sizeof(PoeOneginStringPair), NULL);
+
+  free(pairs);
+
+  return status;
+} // poeSaveOneginGenerator function end
+
+PoeStatus POE_API
+poeLoadOneginGenerator( const PoeText *const text, const char *const fileName, PoeOneginGenerator *const generator ) {
+  assert(text != NULL);
+  assert(fileName != NULL);
+  assert(generator != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
+  memset(generator, 0, sizeof(PoeOneginGenerator));
+
+  PoeFileMapping mapping;
+  PoeStatus status;
+
+  // pair strings are indices in initial order, so text is hashed in it by compact text
+  if (!POE_CHECK(status = poeCreateCompactText(text, &generator->lines, NULL)))
+    return status;
+
+  status = poeSnapshotMap(
+    fileName,
+    POE_SNAPSHOT_KIND_ONEGIN_GENERATOR,
+    text,
+    poeSnapshotHashCompactText(&generator->lines),
+    sizeof(PoeOneginStringPair),
+    &mapping
+  );
+
+  if (!POE_CHECK(status)) {
+    poeDestroyCompactText(&generator->lines);
+    return status;
+  }
+
+  const PoeSnapshotHeader *const header = (const PoeSnapshotHeader *)mapping.data;
+  const PoeOneginStringPair *const pairs = (const PoeOneginStringPair *)(header + 1);
+  const size_t pairCount = (size_t)header->recordCount;
+  PoeBool ok = header->indexCount == 0 && pairCount % POE_ONEGIN_BUCKET_COUNT == 0;
+
+  // validation pass only: pairs are used straight from mapping
+  for (size_t i = 0; ok && i < pairCount; i++)
+    ok = pairs[i].first < text->stringCount && pairs[i].second < text->stringCount;
+
+  if (!ok) {
+    poeUnmapFile(&mapping);
+    poeDestroyCompactText(&generator->lines);
+    return POE_STATUS_BAD_FORMAT;
+  }
+
+  for (size_t i = 0; i < POE_ONEGIN_BUCKET_COUNT; i++) {
+    generator->buckets[i].stringPairSet = pairs + pairCount / POE_ONEGIN_BUCKET_COUNT * i;
+    generator->buckets[i].stringPairCount = pairCount / POE_ONEGIN_BUCKET_COUNT;
+  }
+
+  generator->stringPairCount = pairCount;
+  generator->stringPairCapacity = pairCount / POE_ONEGIN_BUCKET_COUNT;
+  generator->snapshot = mapping;
+  generator->text = text;
+
+  return POE_STATUS_OK;
+} // poeLoadOneginGenerator function end
+
+PoeStatus POE_API
+poeSaveGenerator( const PoeGenerator *const generator, const char *const fileName ) {
+  assert(generator != NULL);
+  assert(generator->text != NULL);
+  assert(fileName != NULL);
+
+  size_t indexCount = 0;
+  PoeBool isPacked = POE_TRUE;
+
+  for (size_t i = 0; i < generator->endingCount; i++) {
+    isPacked = isPacked && generator->endings[i].poolOffset == indexCount;
+    indexCount += generator->endings[i].stringCount;
+  }
+
+  PoeSnapshotHeader header;
+
+  poeSnapshotInitHeader(
+    &header,
+    POE_SNAPSHOT_KIND_GENERATOR,
+    generator->text,
+    poeSnapshotHashText(generator->text),
+    generator->endingCount,
+    indexCount
+  );
+
+  if (isPacked)
+    return poeSnapshotWrite(fileName, &header, generator->endings, sizeof(PoeEnding), generator->stringPool);
+
+  // appended string lists have spare space and may be relocated, so tables are packed before write
+  PoeEnding *const endings = (PoeEnding *)poeArenaAllocate(NULL, generator->endingCount * sizeof(PoeEnding) + 1);
+  uint32_t *const stringPool = (uint32_t *)poeArenaAllocate(NULL, indexCount * sizeof(uint32_t) + 1);
+
+  if (endings == NULL || stringPool == NULL) {
+    free(endings);
+    free(stringPool);
+    return POE_STATUS_BAD_ALLOC;
+  }
+
+  uint32_t poolOffset = 0;
+
+  for (size_t i = 0; i < generator->endingCount; i++) {
+    endings[i] = generator->endings[i];
+    endings[i].poolOffset = poolOffset;
+    memcpy(stringPool + poolOffset, generator->stringPool + generator->endings[i].poolOffset, endings[i].stringCount * sizeof(uint32_t));
+    poolOffset += endings[i].stringCount;
+  }
+
+  const PoeStatus status = poeSnapshotWrite(fileName, &header, endings, sizeof(PoeEnding), stringPool);
+
+  free(endings);
+  free(stringPool);
+
+  return status;
+} // poeSaveGenerator function end
+
+PoeStatus POE_API
+poeLoadGenerator( const PoeText *const text, const char *const fileName, PoeGenerator *const generator ) {
+  assert(text != NULL);
+  assert(fileName != NULL);
+  assert(generator != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_GENERATE);
+
+  memset(generator, 0, sizeof(PoeGenerator));
+
+  PoeFileMapping mapping;
+  PoeStatus status;
+
+  if (!POE_CHECK(status = poeSnapshotMap(fileName, POE_SNAPSHOT_KIND_GENERATOR, text, poeSnapshotHashText(text), sizeof(PoeEnding), &mapping)))
+    return status;
+
+  const PoeSnapshotHeader *const header = (const PoeSnapshotHeader *)mapping.data;
+  const PoeEnding *const endings = (const PoeEnding *)(header + 1);
+  const uint32_t *const stringPool = (const uint32_t *)(endings + header->recordCount);
+  const size_t endingCount = (size_t)header->recordCount;
+  const size_t indexCount = (size_t)header->indexCount;
+  PoeBool ok = POE_TRUE;
+
+  // validation pass only: endings and string pool are used straight from mapping
+  for (size_t i = 0; ok && i < endingCount; i++)
+    ok = endings[i].poolOffset <= indexCount && endings[i].stringCount <= indexCount - endings[i].poolOffset;
+
+  for (size_t i = 0; ok && i < indexCount; i++)
+    ok = stringPool[i] < text->stringCount;
+
+  if (!ok) {
+    poeUnmapFile(&mapping);
+    return POE_STATUS_BAD_FORMAT;
+  }
+
+  generator->text        = text;
+  generator->stringPool  = stringPool;
+  generator->endings     = endings;
+  generator->endingCount = endingCount;
+  generator->snapshot    = mapping;
+
+  return POE_STATUS_OK;
+} // poeLoadGenerator function end
+
+// poe_snapshot.cpp file end
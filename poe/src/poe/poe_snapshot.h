@@ -0,0 +1,98 @@
+/**
+ * @file   poe/poe_snapshot.h
+ * @author tiot2
+ * @brief  Poem processor generator snapshot declaration module
+ *
+ * Snapshot is a binary file of fixed-width little-endian records: a PoeSnapshotHeader followed by
+ * generator tables. Generator tables store 32-bit string indices instead of pointers, so they are
+ * written as is and snapshot is valid for any process that loaded the same text (checked by string
+ * count, total length and hash of string bytes). Loading maps
+ * snapshot file and uses tables straight from mapping after single validation pass, so processes
+ * loading same snapshot share its pages.
+ */
+
+#ifndef POE_SNAPSHOT_H_
+#define POE_SNAPSHOT_H_
+
+#include "poe_generator.h"
+#include "poe_onegin_generator.h"
+
+/// snapshot file magic
+#define POE_SNAPSHOT_MAGIC "POESNAP"
+
+/// snapshot format version (incremented on every incompatible format change)
+#define POE_SNAPSHOT_VERSION 3
+
+/// snapshot kind enumeration
+typedef enum __PoeSnapshotKind {
+  POE_SNAPSHOT_KIND_ONEGIN_GENERATOR = 1, ///< PoeOneginGenerator snapshot
+  POE_SNAPSHOT_KIND_GENERATOR        = 2, ///< PoeGenerator snapshot
+} PoeSnapshotKind;
+
+/// snapshot file header representation structure
+typedef struct __PoeSnapshotHeader {
+  char     magic[8];    ///< POE_SNAPSHOT_MAGIC (with terminating '\0')
+  uint32_t version;     ///< POE_SNAPSHOT_VERSION
+  uint32_t kind;        ///< snapshot kind (PoeSnapshotKind)
+  uint64_t stringCount; ///< count of strings in text snapshot is made for
+  uint64_t textLength;  ///< total length of strings in text snapshot is made for
+  uint64_t textHash;    ///< FNV-1a hash of strings of text snapshot is made for (in order snapshot indices refer to)
+  uint64_t recordCount; ///< count of kind-specific records (PoeOneginStringPair or PoeEnding ones)
+  uint64_t indexCount;  ///< count of string indices following records
+} PoeSnapshotHeader;
+
+/**
+ * @brief Onegin generator snapshot saving function
+ *
+ * @param generator generator to save
+ * @param fileName  snapshot file name
+ *
+ * @note pair strings are indices of text strings in initial (parsing) order,
+ *       so snapshot may be saved and loaded while text is sorted in any order
+ *
+ * @return operation status
+ */
+PoeStatus POE_API
+poeSaveOneginGenerator( const PoeOneginGenerator *generator, const char *fileName );
+
+/**
+ * @brief Onegin generator snapshot loading function
+ *
+ * @param text      text snapshot was saved for
+ * @param fileName  snapshot file name
+ * @param generator generator to load (must be destroyed by poeDestroyOneginGenerator, keeps snapshot mapped until then)
+ *
+ * @return operation status (POE_STATUS_BAD_FORMAT if snapshot is invalid or made for other text)
+ */
+PoeStatus POE_API
+poeLoadOneginGenerator( const PoeText *text, const char *fileName, PoeOneginGenerator *generator );
+
+/**
+ * @brief generator snapshot saving function
+ *
+ * @param generator generator to save
+ * @param fileName  snapshot file name
+ *
+ * @note string pool is indices of generator text strings, so text must have
+ *       same string order on loading
+ *
+ * @return operation status
+ */
+PoeStatus POE_API
+poeSaveGenerator( const PoeGenerator *generator, const char *fileName );
+
+/**
+ * @brief generator snapshot loading function
+ *
+ * @param text      text snapshot was saved for
+ * @param fileName  snapshot file name
+ * @param generator generator to load (must be destroyed by poeDestroyGenerator, keeps snapshot mapped until then)
+ *
+ * @return operation status (POE_STATUS_BAD_FORMAT if snapshot is invalid or made for other text)
+ */
+PoeStatus POE_API
+poeLoadGenerator( const PoeText *text, const char *fileName, PoeGenerator *generator );
+
+#endif // !defined(POE_SNAPSHOT_H_)
+
+// poe_snapshot.h file end
@@ -53,6 +53,8 @@ poeTextQsortPartition( PoeString *const array, const size_t begin, const size_t
  */
 static void
 poeTextQsort( PoeString *const arr, const size_t begin, const size_t end, const PoeStringCompareFn compareFn ) {
+  POE_STATS_PARTITION();
+
   if (begin < end) {
     const size_t partition = poeTextQsortPartition(arr, begin, end, compareFn);
 
@@ -62,17 +64,314 @@ poeTextQsort( PoeString *const arr, const size_t begin, const size_t end, const
 } // poeTextQsort function end
 
 void POE_API
-poeSortText( PoeText *const text, const PoeStringCompareFn compareFn ) {
+poeSortTextHoare( PoeText *const text, const PoeStringCompareFn compareFn ) {
   assert(text != NULL);
   assert(compareFn != NULL);
 
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
   if (text->stringCount < 2) {
     return;
   }
 
   poeTextQsort(text->strings, 0, text->stringCount - 1, compareFn);
+} // poeSortTextHoare function end
+
+/**
+ * @brief hybrid sort of range with comparator dispatch function
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compareFn compare function
+ * @param leftmost  POE_TRUE if range has no strings before it that are not greater than range strings
+ * 
+ * @note library compare functions are replaced by inlined functors
+ */
+static void
+poeTextHybridSortDispatch( PoeString *const begin, PoeString *const end, const PoeStringCompareFn compareFn, const PoeBool leftmost ) {
+  if (compareFn == poeCompareFromStart)
+    poeTextHybridSort(begin, end, PoeCompareFromStartFunctor(), leftmost);
+  else if (compareFn == poeCompareFromEnd)
+    poeTextHybridSort(begin, end, PoeCompareFromEndFunctor(), leftmost);
+  else if (compareFn == poeCompareInitialOrder)
+    poeTextHybridSort(begin, end, PoeCompareInitialOrderFunctor(), leftmost);
+  else
+    poeTextHybridSort(begin, end, PoeCompareFnFunctor {compareFn}, leftmost);
+} // poeTextHybridSortDispatch function end
+
+void POE_API
+poeSortText( PoeText *const text, const PoeStringCompareFn compareFn ) {
+  assert(text != NULL);
+  assert(compareFn != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  poeTextHybridSortDispatch(text->strings, text->strings + text->stringCount, compareFn, POE_TRUE);
 } // poeSortText function end
 
+/**
+ * @brief range selection function
+ * 
+ * @param begin     range begin
+ * @param nth       position to put string that would be there in sorted range
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * @param sortHead  strings before nth are sorted too if POE_TRUE
+ */
+template <typename Comparator>
+static void
+poeTextSelect( PoeString *const begin, PoeString *const nth, PoeString *const end, const Comparator &compare, const PoeBool sortHead ) {
+  poeTextIntroSelect(begin, nth, end, compare);
+
+  if (sortHead)
+    poeTextHybridSort(begin, nth, compare, POE_TRUE);
+} // poeTextSelect function end
+
+/**
+ * @brief range selection with comparator dispatch function
+ * 
+ * @param begin     range begin
+ * @param nth       position to put string that would be there in sorted range
+ * @param end       range end (exclusive)
+ * @param compareFn compare function
+ * @param sortHead  strings before nth are sorted too if POE_TRUE
+ */
+static void
+poeTextSelectDispatch( PoeString *const begin, PoeString *const nth, PoeString *const end, const PoeStringCompareFn compareFn, const PoeBool sortHead ) {
+  if (compareFn == poeCompareFromStart)
+    poeTextSelect(begin, nth, end, PoeCompareFromStartFunctor(), sortHead);
+  else if (compareFn == poeCompareFromEnd)
+    poeTextSelect(begin, nth, end, PoeCompareFromEndFunctor(), sortHead);
+  else if (compareFn == poeCompareInitialOrder)
+    poeTextSelect(begin, nth, end, PoeCompareInitialOrderFunctor(), sortHead);
+  else
+    poeTextSelect(begin, nth, end, PoeCompareFnFunctor {compareFn}, sortHead);
+} // poeTextSelectDispatch function end
+
+void POE_API
+poeSelectText( PoeText *const text, const size_t count, const PoeStringCompareFn compareFn ) {
+  assert(text != NULL);
+  assert(compareFn != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  if (count == 0 || text->stringCount == 0)
+    return;
+
+  const size_t nth = (count < text->stringCount ? count : text->stringCount) - 1;
+
+  poeTextSelectDispatch(text->strings, text->strings + nth, text->strings + text->stringCount, compareFn, POE_FALSE);
+} // poeSelectText function end
+
+void POE_API
+poePartialSortText( PoeText *const text, const size_t count, const PoeStringCompareFn compareFn ) {
+  assert(text != NULL);
+  assert(compareFn != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  if (count >= text->stringCount) {
+    poeSortText(text, compareFn);
+    return;
+  }
+
+  if (count == 0)
+    return;
+
+  poeTextSelectDispatch(text->strings, text->strings + count - 1, text->strings + text->stringCount, compareFn, POE_TRUE);
+} // poePartialSortText function end
+
+/**
+ * @brief sorted range tail merging function
+ * 
+ * @param begin   range begin
+ * @param middle  sorted tail begin (strings before it are sorted too)
+ * @param end     range end (exclusive)
+ * @param buffer  buffer for tail strings (at least end - middle elements)
+ * @param compare comparator
+ * 
+ * @note merges from the end, so head strings not greater than every tail one stay in place
+ */
+template <typename Comparator>
+static void
+poeTextMergeTail( PoeString *const begin, PoeString *const middle, PoeString *const end, PoeString *const buffer, const Comparator &compare ) {
+  PoeString *head = middle;
+  PoeString *tail = buffer + (end - middle);
+  PoeString *dst = end;
+
+  memcpy(buffer, middle, (end - middle) * sizeof(PoeString));
+
+  while (tail != buffer) {
+    if (head != begin && compare(head - 1, tail - 1) == POE_ORDERING_MORE)
+      *--dst = *--head;
+    else
+      *--dst = *--tail;
+  }
+} // poeTextMergeTail function end
+
+/**
+ * @brief range tail sorting and merging with comparator dispatch function
+ * 
+ * @param begin     range begin
+ * @param middle    tail begin (strings before it are sorted)
+ * @param end       range end (exclusive)
+ * @param buffer    buffer for tail strings (at least end - middle elements)
+ * @param compareFn compare function
+ */
+static void
+poeTextSortTailDispatch( PoeString *const begin, PoeString *const middle, PoeString *const end, PoeString *const buffer, const PoeStringCompareFn compareFn ) {
+  if (compareFn == poeCompareFromStart) {
+    poeTextHybridSort(middle, end, PoeCompareFromStartFunctor(), POE_TRUE);
+    poeTextMergeTail(begin, middle, end, buffer, PoeCompareFromStartFunctor());
+  } else if (compareFn == poeCompareFromEnd) {
+    poeTextHybridSort(middle, end, PoeCompareFromEndFunctor(), POE_TRUE);
+    poeTextMergeTail(begin, middle, end, buffer, PoeCompareFromEndFunctor());
+  } else if (compareFn == poeCompareInitialOrder) {
+    poeTextHybridSort(middle, end, PoeCompareInitialOrderFunctor(), POE_TRUE);
+    poeTextMergeTail(begin, middle, end, buffer, PoeCompareInitialOrderFunctor());
+  } else {
+    poeTextHybridSort(middle, end, PoeCompareFnFunctor {compareFn}, POE_TRUE);
+    poeTextMergeTail(begin, middle, end, buffer, PoeCompareFnFunctor {compareFn});
+  }
+} // poeTextSortTailDispatch function end
+
+PoeStatus POE_API
+poeSortTextAppended( PoeText *const text, const size_t sortedCount, const PoeStringCompareFn compareFn ) {
+  assert(text != NULL);
+  assert(sortedCount <= text->stringCount);
+  assert(compareFn != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  const size_t tailSize = text->stringCount - sortedCount;
+
+  if (tailSize == 0)
+    return POE_STATUS_OK;
+
+  PoeString *const buffer = (PoeString *)poeArenaAllocate(NULL, tailSize * sizeof(PoeString));
+
+  if (buffer == NULL)
+    return POE_STATUS_BAD_ALLOC;
+
+  poeTextSortTailDispatch(text->strings, text->strings + sortedCount, text->strings + text->stringCount, buffer, compareFn);
+  free(buffer);
+
+  return POE_STATUS_OK;
+} // poeSortTextAppended function end
+
+/// parallel sort context representation structure
+typedef struct __PoeSortParallelContext {
+  PoeString          * strings;   ///< strings to sort
+  PoeStringCompareFn   compareFn; ///< compare function
+} PoeSortParallelContext;
+
+static void POE_API
+poeTextParallelSortTask( PoeParallelWorker *worker, void *context, size_t begin, size_t end );
+
+/**
+ * @brief parallel sort of range function
+ * 
+ * @param worker    worker range is sorted on
+ * @param context   sort context
+ * @param begin     range begin
+ * @param end       inclusive (!!!) range end
+ * @param compare   comparator
+ * 
+ * @note smaller part of every partition is spawned, larger one is processed by current task;
+ *       range is given to sequential hybrid sort after log2(n) unbalanced partitions
+ */
+template <typename Comparator>
+static void
+poeTextParallelSort( PoeParallelWorker *const worker, void *const context, size_t begin, size_t end, const Comparator &compare ) {
+  PoeString *const strings = ((const PoeSortParallelContext *)context)->strings;
+  size_t badAllowed = 0;
+
+  for (size_t s = end - begin + 1; s > 1; s >>= 1)
+    badAllowed++;
+
+  // range is empty (begin == end + 1) if all its strings are equal to string before it
+  while (end + 1 - begin > POE_SORT_PARALLEL_CUTOFF) {
+    const size_t size = end + 1 - begin;
+
+    poeTextChoosePivot(strings + begin, strings + end + 1, compare);
+
+    // string before range is pivot of earlier partition, so it is never moved again and may be read;
+    // pivot is equal to it => strings equal to pivot are moved left and skipped
+    if (begin != 0 && !poeTextLess(strings + begin - 1, strings + begin, compare)) {
+      begin = poeTextPartitionLeft(strings + begin, strings + end + 1, compare) - strings + 1;
+      continue;
+    }
+
+    PoeBool alreadyPartitioned;
+    const size_t pivot = poeTextPartitionRight(strings + begin, strings + end + 1, compare, &alreadyPartitioned) - strings;
+    const size_t leftSize = pivot - begin;
+    const size_t rightSize = end - pivot;
+
+    if (leftSize < size / 8 || rightSize < size / 8) {
+      if (--badAllowed == 0)
+        break;
+      poeTextBreakPatterns(strings + begin, strings + pivot, strings + end + 1);
+    }
+
+    // pivot is at its final place and is never moved again
+    if (leftSize < rightSize) {
+      if (leftSize > 1)
+        poeParallelSpawn(worker, poeTextParallelSortTask, context, begin, pivot - 1);
+      begin = pivot + 1;
+    } else {
+      if (rightSize > 1)
+        poeParallelSpawn(worker, poeTextParallelSortTask, context, pivot + 1, end);
+      end = pivot - 1;
+    }
+  }
+
+  // strings before begin may still be moved by sibling task, so leaf never looks outside its range
+  poeTextHybridSort(strings + begin, strings + end + 1, compare, POE_TRUE);
+} // poeTextParallelSort function end
+
+/**
+ * @brief parallel sort task function
+ * 
+ * @param worker    worker task is executed on
+ * @param context   sort context
+ * @param begin     range begin
+ * @param end       inclusive (!!!) range end
+ * 
+ * @note library compare functions are replaced by inlined functors
+ */
+static void POE_API
+poeTextParallelSortTask( PoeParallelWorker *const worker, void *const context, const size_t begin, const size_t end ) {
+  const PoeStringCompareFn compareFn = ((const PoeSortParallelContext *)context)->compareFn;
+
+  if (compareFn == poeCompareFromStart)
+    poeTextParallelSort(worker, context, begin, end, PoeCompareFromStartFunctor());
+  else if (compareFn == poeCompareFromEnd)
+    poeTextParallelSort(worker, context, begin, end, PoeCompareFromEndFunctor());
+  else if (compareFn == poeCompareInitialOrder)
+    poeTextParallelSort(worker, context, begin, end, PoeCompareInitialOrderFunctor());
+  else
+    poeTextParallelSort(worker, context, begin, end, PoeCompareFnFunctor {compareFn});
+} // poeTextParallelSortTask function end
+
+void POE_API
+poeSortTextParallel( PoeText *const text, const PoeStringCompareFn compareFn, const size_t threadCount ) {
+  assert(text != NULL);
+  assert(compareFn != NULL);
+
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
+  if (text->stringCount < 2)
+    return;
+
+  PoeSortParallelContext context = {
+    .strings = text->strings,
+    .compareFn = compareFn,
+  };
+
+  if (text->stringCount < POE_SORT_PARALLEL_CUTOFF || !poeParallelRun(threadCount, poeTextParallelSortTask, &context, 0, text->stringCount - 1))
+    poeSortText(text, compareFn);
+} // poeSortTextParallel function end
+
 int __cdecl
 poeStdCompareWrapper( void *compareFn, const void *lhs, const void *rhs ) {
   return ((PoeStringCompareFn)compareFn)((const PoeString *)lhs, (const PoeString *)rhs);
@@ -83,6 +382,8 @@ poeSortTextStd( PoeText *const text, const PoeStringCompareFn compareFn ) {
   assert(text != NULL);
   assert(compareFn != NULL);
 
+  POE_STATS_PHASE(POE_STATS_PHASE_SORT);
+
   qsort_s(text->strings, text->stringCount, sizeof(PoeString), poeStdCompareWrapper, (void *)compareFn);
 } // poeSortTextStd function end
 
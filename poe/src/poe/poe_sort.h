@@ -10,15 +10,99 @@
 #include "poe_core.h"
 #include "poe_compare.h"
 
+/// ranges shorter than this are sorted by insertion sort
+#define POE_SORT_INSERTION_CUTOFF 24
+
+/// ranges longer than this use ninther (median of three medians) as pivot
+#define POE_SORT_NINTHER_THRESHOLD 128
+
+/// maximal count of string moves insertion sort of already partitioned range may perform
+#define POE_SORT_PARTIAL_INSERTION_LIMIT 8
+
 /**
  * @brief text sorting function
  * 
  * @param text      text to sort
  * @param compareFn compare function
+ * 
+ * @note pattern-defeating quicksort: median of three/ninther pivot, equal strings separation,
+ *       insertion sort of short ranges, heap sort fallback after log2(n) unbalanced partitions
+ *       and linear time handling of sorted and strictly descending inputs
  */
 void POE_API
 poeSortText( PoeText *text, const PoeStringCompareFn compareFn );
 
+/**
+ * @brief text by classic Hoare quicksort sorting function
+ * 
+ * @param text      text to sort
+ * @param compareFn compare function
+ * 
+ * @note middle element pivot, no degenerate case handling, kept as benchmark baseline
+ */
+void POE_API
+poeSortTextHoare( PoeText *text, const PoeStringCompareFn compareFn );
+
+/**
+ * @brief text smallest strings selecting function
+ * 
+ * @param text      text to select strings in
+ * @param count     count of strings to select
+ * @param compareFn compare function
+ * 
+ * @note count smallest strings are moved to text beginning in unspecified order, (count - 1)-th
+ *       string is the same as after poeSortText; introselect, O(n) on average and O(n log n) in the worst case
+ */
+void POE_API
+poeSelectText( PoeText *text, size_t count, const PoeStringCompareFn compareFn );
+
+/**
+ * @brief text smallest strings partial sorting function
+ * 
+ * @param text      text to partially sort
+ * @param count     count of strings to select and sort
+ * @param compareFn compare function
+ * 
+ * @note count smallest strings are moved to text beginning in sorted order, the rest go after
+ *       them in unspecified order; O(n + count log count) on average
+ */
+void POE_API
+poePartialSortText( PoeText *text, size_t count, const PoeStringCompareFn compareFn );
+
+/**
+ * @brief text with appended strings sorting function
+ * 
+ * @param text        text to sort (first sortedCount strings are sorted, see poeAppendText)
+ * @param sortedCount count of sorted strings at text beginning
+ * @param compareFn   compare function
+ * 
+ * @note appended strings are sorted by poeSortText algorithm and merged into sorted ones from the end,
+ *       so sorted strings not greater than every appended one are never touched: O(m log m + k)
+ *       comparisons for m appended strings and k sorted strings moved. Merge is stable, so appended
+ *       strings go after equal sorted ones
+ * 
+ * @return operation status
+ */
+PoeStatus POE_API
+poeSortTextAppended( PoeText *text, size_t sortedCount, const PoeStringCompareFn compareFn );
+
+/// minimal count of strings sorted in parallel (smaller ranges are sorted sequentially)
+#define POE_SORT_PARALLEL_CUTOFF 8192
+
+/**
+ * @brief text on several threads sorting function
+ * 
+ * @param text        text to sort
+ * @param compareFn   compare function (must be thread-safe)
+ * @param threadCount count of threads (0 for hardware thread count)
+ * 
+ * @note parallel quicksort: ranges larger than POE_SORT_PARALLEL_CUTOFF are partitioned by
+ *       poeSortText pivot choice and partitioning and spawned as tasks on work-stealing scheduler,
+ *       smaller ones (and ones that got log2(n) unbalanced partitions) are sorted by poeSortText algorithm
+ */
+void POE_API
+poeSortTextParallel( PoeText *text, const PoeStringCompareFn compareFn, size_t threadCount );
+
 /**
  * @brief standard library qsort_s compare function wrapper for POE compare functions
  * @param compareFn compare function (passed through qsort_s context)
@@ -0,0 +1,566 @@
+/**
+ * @file   poe/poe_sort_template.h
+ * @author tiot2
+ * @brief  Poem processor text sort template declaration module
+ * 
+ * @note sort helpers are templates over element type (PoeString for text sort) and
+ *       comparator ('PoeOrdering operator()( const Element *, const Element * ) const')
+ */
+
+#ifndef POE_SORT_TEMPLATE_H_
+#define POE_SORT_TEMPLATE_H_
+
+#include "poe_sort.h"
+
+/**
+ * @brief string 'less' predicate function
+ * 
+ * @param lhs       left hand side
+ * @param rhs       right hand side
+ * @param compare   comparator
+ * 
+ * @return POE_TRUE if lhs < rhs, POE_FALSE otherwise
+ */
+template <typename Element, typename Comparator>
+inline PoeBool
+poeTextLess( const Element *const lhs, const Element *const rhs, const Comparator &compare ) {
+  return compare(lhs, rhs) == POE_ORDERING_LESS;
+} // poeTextLess function end
+
+/**
+ * @brief strings swap function
+ * 
+ * @param lhs first string
+ * @param rhs second string
+ */
+template <typename Element>
+inline void
+poeTextSwap( Element *const lhs, Element *const rhs ) {
+  const Element tmp = *lhs;
+
+  *lhs = *rhs;
+  *rhs = tmp;
+} // poeTextSwap function end
+
+/**
+ * @brief two strings sorting function
+ * 
+ * @param a         first string
+ * @param b         second string
+ * @param compare   comparator
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextSort2( Element *const a, Element *const b, const Comparator &compare ) {
+  if (poeTextLess(b, a, compare))
+    poeTextSwap(a, b);
+} // poeTextSort2 function end
+
+/**
+ * @brief three strings sorting function
+ * 
+ * @param a         first string
+ * @param b         second string (median after sort)
+ * @param c         third string
+ * @param compare   comparator
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextSort3( Element *const a, Element *const b, Element *const c, const Comparator &compare ) {
+  poeTextSort2(a, b, compare);
+  poeTextSort2(b, c, compare);
+  poeTextSort2(a, b, compare);
+} // poeTextSort3 function end
+
+/**
+ * @brief insertion sort function
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * @param guarded   POE_FALSE if string before begin is not greater than any string of range (so begin bound check can be omitted)
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextInsertionSort( Element *const begin, Element *const end, const Comparator &compare, const PoeBool guarded ) {
+  for (Element *current = begin + 1; current < end; current++) {
+    if (!poeTextLess(current, current - 1, compare))
+      continue;
+
+    const Element tmp = *current;
+    Element *sift = current;
+
+    do {
+      *sift = *(sift - 1);
+      sift--;
+    } while ((!guarded || sift != begin) && poeTextLess(&tmp, sift - 1, compare));
+
+    *sift = tmp;
+  }
+} // poeTextInsertionSort function end
+
+/**
+ * @brief bounded insertion sort function (used to finish sorting of almost sorted ranges)
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * 
+ * @return POE_TRUE if range is sorted, POE_FALSE if POE_SORT_PARTIAL_INSERTION_LIMIT moves were exceeded
+ */
+template <typename Element, typename Comparator>
+inline PoeBool
+poeTextPartialInsertionSort( Element *const begin, Element *const end, const Comparator &compare ) {
+  size_t moveCount = 0;
+
+  for (Element *current = begin + 1; current < end; current++) {
+    if (!poeTextLess(current, current - 1, compare))
+      continue;
+
+    const Element tmp = *current;
+    Element *sift = current;
+
+    do {
+      *sift = *(sift - 1);
+      sift--;
+    } while (sift != begin && poeTextLess(&tmp, sift - 1, compare));
+
+    *sift = tmp;
+    moveCount += current - sift;
+
+    if (moveCount > POE_SORT_PARTIAL_INSERTION_LIMIT)
+      return current + 1 == end;
+  }
+
+  return POE_TRUE;
+} // poeTextPartialInsertionSort function end
+
+/**
+ * @brief heap sift down function
+ * 
+ * @param heap      heap array
+ * @param index     index of string to sift
+ * @param size      heap size
+ * @param compare   comparator
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextSiftDown( Element *const heap, size_t index, const size_t size, const Comparator &compare ) {
+  const Element tmp = heap[index];
+
+  while (POE_TRUE) {
+    size_t child = index * 2 + 1;
+
+    if (child >= size)
+      break;
+    if (child + 1 < size && poeTextLess(heap + child, heap + child + 1, compare))
+      child++;
+    if (!poeTextLess(&tmp, heap + child, compare))
+      break;
+
+    heap[index] = heap[child];
+    index = child;
+  }
+
+  heap[index] = tmp;
+} // poeTextSiftDown function end
+
+/**
+ * @brief heap sort function (worst case fallback)
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextHeapSort( Element *const begin, Element *const end, const Comparator &compare ) {
+  const size_t size = end - begin;
+
+  for (size_t i = size / 2; i > 0; i--)
+    poeTextSiftDown(begin, i - 1, size, compare);
+
+  for (size_t i = size - 1; i > 0; i--) {
+    poeTextSwap(begin, begin + i);
+    poeTextSiftDown(begin, 0, i, compare);
+  }
+} // poeTextHeapSort function end
+
+/**
+ * @brief partition by pivot located at range begin, strings equal to pivot are placed to the right part
+ * 
+ * @param begin              range begin
+ * @param end                range end (exclusive)
+ * @param compare            comparator
+ * @param alreadyPartitioned range was already partitioned flag (output)
+ * 
+ * @return pivot final position
+ */
+template <typename Element, typename Comparator>
+inline Element *
+poeTextPartitionRight( Element *const begin, Element *const end, const Comparator &compare, PoeBool *const alreadyPartitioned ) {
+  const Element pivot = *begin;
+  Element *first = begin;
+  Element *last = end;
+
+  // median of three leaves guard strings on both sides of range
+  while (poeTextLess(++first, &pivot, compare))
+    ;
+
+  if (first - 1 == begin)
+    while (first < last && !poeTextLess(--last, &pivot, compare))
+      ;
+  else
+    while (!poeTextLess(--last, &pivot, compare))
+      ;
+
+  *alreadyPartitioned = first >= last;
+
+  while (first < last) {
+    poeTextSwap(first, last);
+
+    while (poeTextLess(++first, &pivot, compare))
+      ;
+    while (!poeTextLess(--last, &pivot, compare))
+      ;
+  }
+
+  Element *const pivotPosition = first - 1;
+
+  *begin = *pivotPosition;
+  *pivotPosition = pivot;
+
+  return pivotPosition;
+} // poeTextPartitionRight function end
+
+/**
+ * @brief partition by pivot located at range begin, strings equal to pivot are placed to the left part
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * 
+ * @return pivot final position
+ * 
+ * @note used if pivot is equal to string before range, so whole left part consists of strings equal to pivot and
+ *       needs no further sorting (equal keys are separated in linear time)
+ */
+template <typename Element, typename Comparator>
+inline Element *
+poeTextPartitionLeft( Element *const begin, Element *const end, const Comparator &compare ) {
+  const Element pivot = *begin;
+  Element *first = begin;
+  Element *last = end;
+
+  while (poeTextLess(&pivot, --last, compare))
+    ;
+
+  if (last + 1 == end)
+    while (first < last && !poeTextLess(&pivot, ++first, compare))
+      ;
+  else
+    while (!poeTextLess(&pivot, ++first, compare))
+      ;
+
+  while (first < last) {
+    poeTextSwap(first, last);
+
+    while (poeTextLess(&pivot, --last, compare))
+      ;
+    while (!poeTextLess(&pivot, ++first, compare))
+      ;
+  }
+
+  *begin = *last;
+  *last = pivot;
+
+  return last;
+} // poeTextPartitionLeft function end
+
+/**
+ * @brief pivot choosing function
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive, range must be at least POE_SORT_INSERTION_CUTOFF long)
+ * @param compare   comparator
+ * 
+ * @note pivot (median of three or ninther) is moved to range begin, range end - 1 is not less than pivot then
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextChoosePivot( Element *const begin, Element *const end, const Comparator &compare ) {
+  const size_t size = end - begin;
+  const size_t half = size / 2;
+
+  if (size > POE_SORT_NINTHER_THRESHOLD) {
+    poeTextSort3(begin       , begin + half    , end - 1, compare);
+    poeTextSort3(begin + 1   , begin + half - 1, end - 2, compare);
+    poeTextSort3(begin + 2   , begin + half + 1, end - 3, compare);
+    poeTextSort3(begin + half - 1, begin + half, begin + half + 1, compare);
+    poeTextSwap(begin, begin + half);
+  } else {
+    poeTextSort3(begin + half, begin, end - 1, compare);
+  }
+} // poeTextChoosePivot function end
+
+/**
+ * @brief patterns that caused unbalanced partition breaking function
+ * 
+ * @param begin     range begin
+ * @param pivot     partition pivot
+ * @param end       range end (exclusive)
+ * 
+ * @note swaps several strings of both parts, so next pivots are chosen from other strings
+ */
+template <typename Element>
+inline void
+poeTextBreakPatterns( Element *const begin, Element *const pivot, Element *const end ) {
+  const size_t leftSize = pivot - begin;
+  const size_t rightSize = end - (pivot + 1);
+
+  if (leftSize >= POE_SORT_INSERTION_CUTOFF) {
+    poeTextSwap(begin    , begin + leftSize / 4);
+    poeTextSwap(pivot - 1, pivot - leftSize / 4);
+
+    if (leftSize > POE_SORT_NINTHER_THRESHOLD) {
+      poeTextSwap(begin + 1, begin + (leftSize / 4 + 1));
+      poeTextSwap(begin + 2, begin + (leftSize / 4 + 2));
+      poeTextSwap(pivot - 2, pivot - (leftSize / 4 + 1));
+      poeTextSwap(pivot - 3, pivot - (leftSize / 4 + 2));
+    }
+  }
+  if (rightSize >= POE_SORT_INSERTION_CUTOFF) {
+    poeTextSwap(pivot + 1, pivot + 1 + rightSize / 4);
+    poeTextSwap(end - 1  , end - rightSize / 4);
+
+    if (rightSize > POE_SORT_NINTHER_THRESHOLD) {
+      poeTextSwap(pivot + 2, pivot + (2 + rightSize / 4));
+      poeTextSwap(pivot + 3, pivot + (3 + rightSize / 4));
+      poeTextSwap(end - 2  , end - (1 + rightSize / 4));
+      poeTextSwap(end - 3  , end - (2 + rightSize / 4));
+    }
+  }
+} // poeTextBreakPatterns function end
+
+/**
+ * @brief pattern-defeating introsort function
+ * 
+ * @param begin          range begin
+ * @param end            range end (exclusive)
+ * @param compare        comparator
+ * @param badAllowed     count of unbalanced partitions allowed before heap sort fallback
+ * @param leftmost       POE_TRUE if range has no strings before it that are not greater than range strings
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextIntroSort( Element *begin, Element *const end, const Comparator &compare, size_t badAllowed, PoeBool leftmost ) {
+  POE_STATS_PARTITION();
+
+  while (POE_TRUE) {
+    const size_t size = end - begin;
+
+    if (size < POE_SORT_INSERTION_CUTOFF) {
+      poeTextInsertionSort(begin, end, compare, leftmost);
+      return;
+    }
+
+    poeTextChoosePivot(begin, end, compare);
+
+    // pivot is equal to previous range string => strings equal to pivot are moved left and skipped
+    if (!leftmost && !poeTextLess(begin - 1, begin, compare)) {
+      begin = poeTextPartitionLeft(begin, end, compare) + 1;
+      continue;
+    }
+
+    PoeBool alreadyPartitioned;
+    Element *const pivot = poeTextPartitionRight(begin, end, compare, &alreadyPartitioned);
+
+    const size_t leftSize = pivot - begin;
+    const size_t rightSize = end - (pivot + 1);
+
+    if (leftSize < size / 8 || rightSize < size / 8) {
+      if (--badAllowed == 0) {
+        poeTextHeapSort(begin, end, compare);
+        return;
+      }
+
+      poeTextBreakPatterns(begin, pivot, end);
+    } else if (alreadyPartitioned) {
+      // no swaps were performed => range is probably (almost) sorted
+      if (poeTextPartialInsertionSort(begin, pivot, compare) && poeTextPartialInsertionSort(pivot + 1, end, compare))
+        return;
+    }
+
+    poeTextIntroSort(begin, pivot, compare, badAllowed, leftmost);
+    begin = pivot + 1;
+    leftmost = POE_FALSE;
+  }
+} // poeTextIntroSort function end
+
+/**
+ * @brief sorted run detection function
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * 
+ * @return POE_TRUE if range turned out to be sorted (strictly descending ranges are reversed), POE_FALSE otherwise
+ */
+template <typename Element, typename Comparator>
+inline PoeBool
+poeTextSortRun( Element *const begin, Element *const end, const Comparator &compare ) {
+  Element *current = begin + 1;
+
+  if (poeTextLess(current, begin, compare)) {
+    while (current + 1 < end && poeTextLess(current + 1, current, compare))
+      current++;
+
+    if (current + 1 != end)
+      return POE_FALSE;
+
+    for (Element *left = begin, *right = end - 1; left < right; left++, right--)
+      poeTextSwap(left, right);
+
+    return POE_TRUE;
+  }
+
+  while (current + 1 < end && !poeTextLess(current + 1, current, compare))
+    current++;
+
+  return current + 1 == end;
+} // poeTextSortRun function end
+
+/**
+ * @brief hybrid sort of range function
+ * 
+ * @param begin     range begin
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * @param leftmost  POE_TRUE if range has no strings before it that are not greater than range strings
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextHybridSort( Element *const begin, Element *const end, const Comparator &compare, const PoeBool leftmost ) {
+  const size_t size = end - begin;
+
+  if (size < 2 || poeTextSortRun(begin, end, compare))
+    return;
+
+  size_t log2Size = 0;
+
+  for (size_t s = size; s > 1; s >>= 1)
+    log2Size++;
+
+  poeTextIntroSort(begin, end, compare, log2Size, leftmost);
+} // poeTextHybridSort function end
+
+/**
+ * @brief heap selection function (introselect worst case fallback)
+ * 
+ * @param begin     range begin
+ * @param nth       position to put string that would be there in sorted range
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * 
+ * @note strings before nth are not greater than nth one, strings after it are not less
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextHeapSelect( Element *const begin, Element *const nth, Element *const end, const Comparator &compare ) {
+  const size_t heapSize = nth - begin + 1;
+
+  // max-heap of heapSize smallest strings
+  for (size_t i = heapSize / 2; i > 0; i--)
+    poeTextSiftDown(begin, i - 1, heapSize, compare);
+
+  for (Element *current = nth + 1; current < end; current++)
+    if (poeTextLess(current, begin, compare)) {
+      poeTextSwap(current, begin);
+      poeTextSiftDown(begin, 0, heapSize, compare);
+    }
+
+  poeTextSwap(begin, nth);
+} // poeTextHeapSelect function end
+
+/**
+ * @brief introselect function
+ * 
+ * @param begin     range begin
+ * @param nth       position to put string that would be there in sorted range
+ * @param end       range end (exclusive)
+ * @param compare   comparator
+ * 
+ * @note strings before nth are not greater than nth one, strings after it are not less;
+ *       quickselect with heap selection fallback after log2(n) unbalanced partitions
+ */
+template <typename Element, typename Comparator>
+inline void
+poeTextIntroSelect( Element *begin, Element *const nth, Element *end, const Comparator &compare ) {
+  size_t badAllowed = 0;
+  PoeBool leftmost = POE_TRUE;
+
+  for (size_t s = end - begin; s > 1; s >>= 1)
+    badAllowed++;
+
+  while ((size_t)(end - begin) >= POE_SORT_INSERTION_CUTOFF) {
+    const size_t size = end - begin;
+
+    poeTextChoosePivot(begin, end, compare);
+
+    // pivot is equal to previous range string => strings equal to pivot are moved left and skipped
+    if (!leftmost && !poeTextLess(begin - 1, begin, compare)) {
+      Element *const last = poeTextPartitionLeft(begin, end, compare);
+
+      if (nth <= last)
+        return;
+      begin = last + 1;
+      continue;
+    }
+
+    PoeBool alreadyPartitioned;
+    Element *const pivot = poeTextPartitionRight(begin, end, compare, &alreadyPartitioned);
+
+    if (pivot == nth)
+      return;
+
+    if ((size_t)(pivot - begin) < size / 8 || (size_t)(end - pivot - 1) < size / 8)
+      if (--badAllowed == 0) {
+        if (nth < pivot)
+          poeTextHeapSelect(begin, nth, pivot, compare);
+        else
+          poeTextHeapSelect(pivot + 1, nth, end, compare);
+        return;
+      }
+
+    if (nth < pivot) {
+      end = pivot;
+    } else {
+      begin = pivot + 1;
+      leftmost = POE_FALSE;
+    }
+  }
+
+  poeTextInsertionSort(begin, end, compare, leftmost);
+} // poeTextIntroSelect function end
+
+/**
+ * @brief text sorting template function
+ * 
+ * @tparam Comparator comparator type ('PoeOrdering operator()( const PoeString *, const PoeString * ) const')
+ * 
+ * @param text    text to sort
+ * @param compare comparator
+ * 
+ * @note same algorithm as poeSortText, but comparator calls are inlined into sort loops
+ */
+template <typename Comparator>
+inline void
+poeSortTextT( PoeText *const text, const Comparator &compare = Comparator() ) {
+  assert(text != NULL);
+
+  poeTextHybridSort(text->strings, text->strings + text->stringCount, compare, POE_TRUE);
+} // poeSortTextT function end
+
+#endif // !defined(POE_SORT_TEMPLATE_H_)
+
+// poe_sort_template.h file end
@@ -0,0 +1,118 @@
+/**
+ * @file   poe/poe_stats.cpp
+ * @author tiot2
+ * @brief  Poem processor instrumentation counters implementation module
+ */
+
+#include <atomic>
+#include <chrono>
+
+#include "poe_stats.h"
+
+thread_local PoeStatsThreadCounters poeStatsThreadCounters = {0};
+
+/// global (flushed) counters representation structure
+typedef struct __PoeStatsGlobalCounters {
+  std::atomic<uint64_t> comparisonCount;                      ///< count of string comparator calls
+  std::atomic<uint64_t> comparedByteCount;                    ///< count of bytes scanned by string comparators
+  std::atomic<uint64_t> partitionCount;                       ///< count of sort partitioning steps
+  std::atomic<uint64_t> maxPartitionDepth;                    ///< maximal sort partitioning recursion depth
+  std::atomic<uint64_t> allocationCount;                      ///< count of allocations (heap and arena)
+  std::atomic<uint64_t> allocatedByteCount;                   ///< count of allocated bytes (heap and arena)
+  std::atomic<uint64_t> phaseCallCount[POE_STATS_PHASE_COUNT]; ///< count of phase calls
+  std::atomic<uint64_t> phaseTime[POE_STATS_PHASE_COUNT];      ///< total phase time (in nanoseconds)
+} PoeStatsGlobalCounters;
+
+/// global counters
+static PoeStatsGlobalCounters poeStatsGlobalCounters;
+
+void POE_API
+poeStatsFlushThread( void ) {
+  PoeStatsThreadCounters *const counters = &poeStatsThreadCounters;
+  PoeStatsGlobalCounters *const global = &poeStatsGlobalCounters;
+
+  global->comparisonCount.fetch_add(counters->comparisonCount, std::memory_order_relaxed);
+  global->comparedByteCount.fetch_add(counters->comparedByteCount, std::memory_order_relaxed);
+  global->partitionCount.fetch_add(counters->partitionCount, std::memory_order_relaxed);
+  global->allocationCount.fetch_add(counters->allocationCount, std::memory_order_relaxed);
+  global->allocatedByteCount.fetch_add(counters->allocatedByteCount, std::memory_order_relaxed);
+
+  uint64_t maxDepth = global->maxPartitionDepth.load(std::memory_order_relaxed);
+
+  while (maxDepth < counters->maxPartitionDepth && !global->maxPartitionDepth.compare_exchange_weak(maxDepth, counters->maxPartitionDepth))
+    ;
+
+  // current depths are kept, as flush may happen inside of phase
+  counters->comparisonCount = 0;
+  counters->comparedByteCount = 0;
+  counters->partitionCount = 0;
+  counters->maxPartitionDepth = 0;
+  counters->allocationCount = 0;
+  counters->allocatedByteCount = 0;
+} // poeStatsFlushThread function end
+
+void POE_API
+poeStatsGet( PoeStats *const dst ) {
+  assert(dst != NULL);
+
+  PoeStatsGlobalCounters *const global = &poeStatsGlobalCounters;
+
+  poeStatsFlushThread();
+
+  dst->comparisonCount = global->comparisonCount.load(std::memory_order_relaxed);
+  dst->comparedByteCount = global->comparedByteCount.load(std::memory_order_relaxed);
+  dst->partitionCount = global->partitionCount.load(std::memory_order_relaxed);
+  dst->maxPartitionDepth = global->maxPartitionDepth.load(std::memory_order_relaxed);
+  dst->allocationCount = global->allocationCount.load(std::memory_order_relaxed);
+  dst->allocatedByteCount = global->allocatedByteCount.load(std::memory_order_relaxed);
+
+  for (size_t i = 0; i < POE_STATS_PHASE_COUNT; i++) {
+    dst->phaseCallCount[i] = global->phaseCallCount[i].load(std::memory_order_relaxed);
+    dst->phaseTime[i] = (double)global->phaseTime[i].load(std::memory_order_relaxed) / 1e9;
+  }
+} // poeStatsGet function end
+
+void POE_API
+poeStatsReset( void ) {
+  PoeStatsGlobalCounters *const global = &poeStatsGlobalCounters;
+
+  poeStatsFlushThread();
+
+  global->comparisonCount.store(0, std::memory_order_relaxed);
+  global->comparedByteCount.store(0, std::memory_order_relaxed);
+  global->partitionCount.store(0, std::memory_order_relaxed);
+  global->maxPartitionDepth.store(0, std::memory_order_relaxed);
+  global->allocationCount.store(0, std::memory_order_relaxed);
+  global->allocatedByteCount.store(0, std::memory_order_relaxed);
+
+  for (size_t i = 0; i < POE_STATS_PHASE_COUNT; i++) {
+    global->phaseCallCount[i].store(0, std::memory_order_relaxed);
+    global->phaseTime[i].store(0, std::memory_order_relaxed);
+  }
+} // poeStatsReset function end
+
+const char * POE_API
+poeStatsGetPhaseName( const PoeStatsPhase phase ) {
+  switch (phase) {
+  case POE_STATS_PHASE_PARSE   : return "parse";
+  case POE_STATS_PHASE_SORT    : return "sort";
+  case POE_STATS_PHASE_GENERATE: return "generate";
+  case POE_STATS_PHASE_WRITE   : return "write";
+  default                      : return "unknown";
+  }
+} // poeStatsGetPhaseName function end
+
+double POE_API
+poeStatsGetTime( void ) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} // poeStatsGetTime function end
+
+void POE_API
+poeStatsAddPhaseTime( const PoeStatsPhase phase, const double time ) {
+  assert(phase < POE_STATS_PHASE_COUNT);
+
+  poeStatsGlobalCounters.phaseCallCount[phase].fetch_add(1, std::memory_order_relaxed);
+  poeStatsGlobalCounters.phaseTime[phase].fetch_add((uint64_t)(time * 1e9), std::memory_order_relaxed);
+} // poeStatsAddPhaseTime function end
+
+// poe_stats.cpp file end
@@ -0,0 +1,200 @@
+/**
+ * @file   poe/poe_stats.h
+ * @author tiot2
+ * @brief  Poem processor instrumentation counters declaration module
+ *
+ * @note counters are enabled by default; define POE_STATS_DISABLED to compile them out
+ *       (all POE_STATS_* macros expand to nothing then)
+ */
+
+#ifndef POE_STATS_H_
+#define POE_STATS_H_
+
+#include "poe_core.h"
+
+#ifdef POE_STATS_DISABLED
+/// instrumentation enabled flag
+#define POE_STATS_ENABLED 0
+#else
+/// instrumentation enabled flag
+#define POE_STATS_ENABLED 1
+#endif
+
+/// instrumented pipeline phase enumeration
+typedef enum __PoeStatsPhase {
+  POE_STATS_PHASE_PARSE,    ///< text parsing (poeParseText* functions)
+  POE_STATS_PHASE_SORT,     ///< text sorting (poeSortText* and selection functions)
+  POE_STATS_PHASE_GENERATE, ///< generator building (poeCreate*Generator functions)
+  POE_STATS_PHASE_WRITE,    ///< text writing (poeWriteText function)
+
+  POE_STATS_PHASE_COUNT,    ///< count of phases
+} PoeStatsPhase;
+
+/// instrumentation counters snapshot representation structure
+typedef struct __PoeStats {
+  uint64_t comparisonCount;                      ///< count of string comparator calls
+  uint64_t comparedByteCount;                    ///< count of bytes scanned by string comparators
+  uint64_t partitionCount;                       ///< count of sort partitioning steps
+  uint64_t maxPartitionDepth;                    ///< maximal sort partitioning recursion depth
+  uint64_t allocationCount;                      ///< count of allocations (heap and arena)
+  uint64_t allocatedByteCount;                   ///< count of allocated bytes (heap and arena)
+  uint64_t phaseCallCount[POE_STATS_PHASE_COUNT]; ///< count of phase (outermost) calls
+  double   phaseTime[POE_STATS_PHASE_COUNT];      ///< total phase time (in seconds)
+} PoeStats;
+
+/// per-thread instrumentation counters representation structure
+typedef struct __PoeStatsThreadCounters {
+  uint64_t comparisonCount;                   ///< count of string comparator calls
+  uint64_t comparedByteCount;                 ///< count of bytes scanned by string comparators
+  uint64_t partitionCount;                    ///< count of sort partitioning steps
+  uint64_t partitionDepth;                    ///< current sort partitioning recursion depth
+  uint64_t maxPartitionDepth;                 ///< maximal sort partitioning recursion depth
+  uint64_t allocationCount;                   ///< count of allocations (heap and arena)
+  uint64_t allocatedByteCount;                ///< count of allocated bytes (heap and arena)
+  uint32_t phaseDepth[POE_STATS_PHASE_COUNT]; ///< current phase nesting depth
+} PoeStatsThreadCounters;
+
+/// calling thread counters (flushed to global ones by poeStatsFlushThread)
+extern thread_local PoeStatsThreadCounters poeStatsThreadCounters;
+
+/**
+ * @brief calling thread counters to global counters adding function
+ *
+ * @note must be called by every thread counting something before it exits (parallel workers do it)
+ */
+void POE_API
+poeStatsFlushThread( void );
+
+/**
+ * @brief global counters snapshot getting function
+ *
+ * @param dst snapshot destination
+ *
+ * @note flushes calling thread counters
+ */
+void POE_API
+poeStatsGet( PoeStats *dst );
+
+/**
+ * @brief global and calling thread counters resetting function
+ */
+void POE_API
+poeStatsReset( void );
+
+/**
+ * @brief phase name getting function
+ *
+ * @param phase phase to get name of
+ *
+ * @return phase name
+ */
+const char * POE_API
+poeStatsGetPhaseName( PoeStatsPhase phase );
+
+/**
+ * @brief current time getting function
+ *
+ * @return time in seconds from unspecified moment
+ */
+double POE_API
+poeStatsGetTime( void );
+
+/**
+ * @brief outermost phase time adding function
+ *
+ * @param phase phase
+ * @param time  phase call time (in seconds)
+ */
+void POE_API
+poeStatsAddPhaseTime( PoeStatsPhase phase, double time );
+
+/// phase timing scope (only outermost scope of phase on thread is timed)
+struct PoeStatsPhaseScope {
+  PoeStatsPhase phase;     ///< phase
+  double        startTime; ///< scope start time (outermost scope only)
+
+  /**
+   * @brief phase scope constructor
+   *
+   * @param phase phase scope belongs to
+   */
+  inline
+  PoeStatsPhaseScope( const PoeStatsPhase phase ) : phase(phase), startTime(0.0) {
+    if (poeStatsThreadCounters.phaseDepth[phase]++ == 0)
+      startTime = poeStatsGetTime();
+  } // PoeStatsPhaseScope constructor end
+
+  /**
+   * @brief phase scope destructor
+   */
+  inline
+  ~PoeStatsPhaseScope( void ) {
+    if (--poeStatsThreadCounters.phaseDepth[phase] == 0)
+      poeStatsAddPhaseTime(phase, poeStatsGetTime() - startTime);
+  } // PoeStatsPhaseScope destructor end
+}; // struct PoeStatsPhaseScope end
+
+/// sort partitioning recursion depth tracking scope
+struct PoeStatsPartitionScope {
+  /**
+   * @brief partition scope constructor
+   */
+  inline
+  PoeStatsPartitionScope( void ) {
+    PoeStatsThreadCounters *const counters = &poeStatsThreadCounters;
+
+    counters->partitionCount++;
+    if (++counters->partitionDepth > counters->maxPartitionDepth)
+      counters->maxPartitionDepth = counters->partitionDepth;
+  } // PoeStatsPartitionScope constructor end
+
+  /**
+   * @brief partition scope destructor
+   */
+  inline
+  ~PoeStatsPartitionScope( void ) {
+    poeStatsThreadCounters.partitionDepth--;
+  } // PoeStatsPartitionScope destructor end
+}; // struct PoeStatsPartitionScope end
+
+#if POE_STATS_ENABLED
+
+/// string comparison counting macro
+#define POE_STATS_COMPARISON(byteCount)                          \
+  do {                                                           \
+    poeStatsThreadCounters.comparisonCount++;                    \
+    poeStatsThreadCounters.comparedByteCount += (byteCount);     \
+  } while (0)
+
+/// allocation counting macro (used by poeArena* allocation functions only)
+#define POE_STATS_ALLOCATION(size)                               \
+  do {                                                           \
+    poeStatsThreadCounters.allocationCount++;                    \
+    poeStatsThreadCounters.allocatedByteCount += (size);         \
+  } while (0)
+
+/// current scope as phase timing macro
+#define POE_STATS_PHASE(phase) PoeStatsPhaseScope poeStatsPhaseScope(phase)
+
+/// current scope as sort partitioning step marking macro
+#define POE_STATS_PARTITION() PoeStatsPartitionScope poeStatsPartitionScope
+
+#else
+
+/// string comparison counting macro
+#define POE_STATS_COMPARISON(byteCount) ((void)0)
+
+/// allocation counting macro (used by poeArena* allocation functions only)
+#define POE_STATS_ALLOCATION(size) ((void)0)
+
+/// current scope as phase timing macro
+#define POE_STATS_PHASE(phase) ((void)0)
+
+/// current scope as sort partitioning step marking macro
+#define POE_STATS_PARTITION() ((void)0)
+
+#endif // POE_STATS_ENABLED
+
+#endif // !defined(POE_STATS_H_)
+
+// poe_stats.h file end